@@ -0,0 +1,387 @@
+#include "bigint.h"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace runtime {
+
+    BigInt::BigInt(int64_t value)
+        : negative_(value < 0)
+    {
+        //  INT64_MIN    int64_t,     uint64_t
+        uint64_t magnitude = negative_ ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+        while (magnitude != 0) {
+            magnitude_.push_back(static_cast<uint32_t>(magnitude));
+            magnitude >>= 32;
+        }
+    }
+
+    BigInt::BigInt(bool negative, Limbs magnitude)
+        : negative_(negative)
+        , magnitude_(move(magnitude))
+    {
+        Trim(magnitude_);
+        if (magnitude_.empty()) {
+            negative_ = false;
+        }
+    }
+
+    BigInt BigInt::FromString(string_view decimal) {
+        bool negative = false;
+        if (!decimal.empty() && decimal.front() == '-') {
+            negative = true;
+            decimal.remove_prefix(1);
+        }
+        if (decimal.empty() || decimal.find_first_not_of("0123456789"sv) != string_view::npos) {
+            throw invalid_argument("Invalid integer: "s + string(decimal));
+        }
+        Limbs magnitude;
+        for (char digit : decimal) {
+            uint64_t carry = static_cast<uint64_t>(digit - '0');
+            for (uint32_t& limb : magnitude) {
+                uint64_t value = static_cast<uint64_t>(limb) * 10 + carry;
+                limb = static_cast<uint32_t>(value);
+                carry = value >> 32;
+            }
+            if (carry != 0) {
+                magnitude.push_back(static_cast<uint32_t>(carry));
+            }
+        }
+        return BigInt(negative, move(magnitude));
+    }
+
+    bool BigInt::IsZero() const {
+        return magnitude_.empty();
+    }
+
+    bool BigInt::IsNegative() const {
+        return negative_;
+    }
+
+    bool BigInt::FitsInt64() const {
+        if (magnitude_.size() > 2) {
+            return false;
+        }
+        uint64_t magnitude = 0;
+        for (size_t i = magnitude_.size(); i-- > 0;) {
+            magnitude = (magnitude << 32) | magnitude_[i];
+        }
+        const uint64_t limit = static_cast<uint64_t>(numeric_limits<int64_t>::max()) + (negative_ ? 1 : 0);
+        return magnitude <= limit;
+    }
+
+    int64_t BigInt::ToInt64() const {
+        uint64_t magnitude = 0;
+        for (size_t i = magnitude_.size(); i-- > 0;) {
+            magnitude = (magnitude << 32) | magnitude_[i];
+        }
+        return negative_ ? static_cast<int64_t>(~magnitude + 1) : static_cast<int64_t>(magnitude);
+    }
+
+    string BigInt::ToString() const {
+        if (magnitude_.empty()) {
+            return "0"s;
+        }
+        //   9     
+        constexpr uint32_t CHUNK = 1'000'000'000;
+        Limbs magnitude = magnitude_;
+        vector<uint32_t> chunks;
+        while (!magnitude.empty()) {
+            chunks.push_back(DivBySmall(magnitude, CHUNK));
+        }
+        string result = negative_ ? "-"s : ""s;
+        result += to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            string chunk = to_string(chunks[i]);
+            result.append(9 - chunk.size(), '0');
+            result += chunk;
+        }
+        return result;
+    }
+
+    BigInt BigInt::operator-() const {
+        return BigInt(!negative_, magnitude_);
+    }
+
+    void BigInt::Trim(Limbs& limbs) {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+    }
+
+    int BigInt::CompareMagnitudes(const Limbs& lhs, const Limbs& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return lhs.size() < rhs.size() ? -1 : 1;
+        }
+        for (size_t i = lhs.size(); i-- > 0;) {
+            if (lhs[i] != rhs[i]) {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    BigInt::Limbs BigInt::AddMagnitudes(const Limbs& lhs, const Limbs& rhs) {
+        const Limbs& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+        const Limbs& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+        Limbs result(longer.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.size(); ++i) {
+            uint64_t sum = static_cast<uint64_t>(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+            result[i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        result[longer.size()] = static_cast<uint32_t>(carry);
+        Trim(result);
+        return result;
+    }
+
+    BigInt::Limbs BigInt::SubMagnitudes(const Limbs& lhs, const Limbs& rhs) {
+        Limbs result(lhs.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            int64_t diff = static_cast<int64_t>(lhs[i]) - (i < rhs.size() ? rhs[i] : 0) - borrow;
+            borrow = diff < 0 ? 1 : 0;
+            result[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        }
+        Trim(result);
+        return result;
+    }
+
+    BigInt::Limbs BigInt::SchoolbookMul(const Limbs& lhs, const Limbs& rhs) {
+        Limbs result(lhs.size() + rhs.size());
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < rhs.size(); ++j) {
+                uint64_t value = static_cast<uint64_t>(lhs[i]) * rhs[j] + result[i + j] + carry;
+                result[i + j] = static_cast<uint32_t>(value);
+                carry = value >> 32;
+            }
+            result[i + rhs.size()] = static_cast<uint32_t>(carry);
+        }
+        Trim(result);
+        return result;
+    }
+
+    BigInt::Limbs BigInt::KaratsubaMul(const Limbs& lhs, const Limbs& rhs) {
+        // lhs = lhs_high * B^half + lhs_low, rhs = rhs_high * B^half + rhs_low
+        const size_t half = max(lhs.size(), rhs.size()) / 2;
+        auto split = [half](const Limbs& limbs) {
+            const size_t border = min(half, limbs.size());
+            Limbs low(limbs.begin(), limbs.begin() + border);
+            Limbs high(limbs.begin() + border, limbs.end());
+            Trim(low);
+            return make_pair(move(low), move(high));
+        };
+        auto [lhs_low, lhs_high] = split(lhs);
+        auto [rhs_low, rhs_high] = split(rhs);
+
+        Limbs low = MulMagnitudes(lhs_low, rhs_low);
+        Limbs high = MulMagnitudes(lhs_high, rhs_high);
+        Limbs middle = MulMagnitudes(AddMagnitudes(lhs_low, lhs_high), AddMagnitudes(rhs_low, rhs_high));
+        middle = SubMagnitudes(SubMagnitudes(middle, low), high);
+
+        Limbs result(lhs.size() + rhs.size() + 1);
+        auto add_shifted = [&result](const Limbs& term, size_t shift) {
+            uint64_t carry = 0;
+            size_t i = 0;
+            for (; i < term.size(); ++i) {
+                uint64_t sum = static_cast<uint64_t>(result[i + shift]) + term[i] + carry;
+                result[i + shift] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            for (; carry != 0; ++i) {
+                uint64_t sum = static_cast<uint64_t>(result[i + shift]) + carry;
+                result[i + shift] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+        };
+        add_shifted(low, 0);
+        add_shifted(middle, half);
+        add_shifted(high, 2 * half);
+        Trim(result);
+        return result;
+    }
+
+    BigInt::Limbs BigInt::MulMagnitudes(const Limbs& lhs, const Limbs& rhs) {
+        if (lhs.empty() || rhs.empty()) {
+            return {};
+        }
+        if (min(lhs.size(), rhs.size()) < KARATSUBA_THRESHOLD) {
+            return SchoolbookMul(lhs, rhs);
+        }
+        return KaratsubaMul(lhs, rhs);
+    }
+
+    uint32_t BigInt::DivBySmall(Limbs& limbs, uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            uint64_t value = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(value / divisor);
+            remainder = value % divisor;
+        }
+        Trim(limbs);
+        return static_cast<uint32_t>(remainder);
+    }
+
+    BigInt::Limbs BigInt::DivMagnitudes(const Limbs& lhs, const Limbs& rhs) {
+        if (CompareMagnitudes(lhs, rhs) < 0) {
+            return {};
+        }
+        if (rhs.size() == 1) {
+            Limbs quotient = lhs;
+            DivBySmall(quotient, rhs[0]);
+            return quotient;
+        }
+
+        //  D :   ,        1
+        const size_t n = rhs.size();
+        const size_t m = lhs.size() - n;
+        int shift = 0;
+        while ((rhs.back() << shift & 0x80000000u) == 0) {
+            ++shift;
+        }
+        auto shift_left = [shift](const Limbs& limbs, size_t size) {
+            Limbs result(size);
+            for (size_t i = 0; i < limbs.size(); ++i) {
+                uint64_t value = static_cast<uint64_t>(limbs[i]) << shift;
+                result[i] |= static_cast<uint32_t>(value);
+                if (i + 1 < size) {
+                    result[i + 1] |= static_cast<uint32_t>(value >> 32);
+                }
+            }
+            return result;
+        };
+        const Limbs v = shift_left(rhs, n);
+        Limbs u = shift_left(lhs, lhs.size() + 1);
+
+        constexpr uint64_t BASE = uint64_t{ 1 } << 32;
+        Limbs quotient(m + 1);
+        for (size_t j = m + 1; j-- > 0;) {
+            const uint64_t numerator = (static_cast<uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+            uint64_t q_hat = numerator / v[n - 1];
+            uint64_t r_hat = numerator % v[n - 1];
+            while (q_hat >= BASE || q_hat * v[n - 2] > ((r_hat << 32) | u[j + n - 2])) {
+                --q_hat;
+                r_hat += v[n - 1];
+                if (r_hat >= BASE) {
+                    break;
+                }
+            }
+
+            int64_t borrow = 0;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t product = q_hat * v[i] + carry;
+                carry = product >> 32;
+                int64_t diff = static_cast<int64_t>(u[i + j]) - static_cast<int64_t>(product & 0xFFFFFFFFu) - borrow;
+                borrow = diff < 0 ? 1 : 0;
+                u[i + j] = static_cast<uint32_t>(diff + (borrow << 32));
+            }
+            int64_t diff = static_cast<int64_t>(u[j + n]) - static_cast<int64_t>(carry) - borrow;
+            u[j + n] = static_cast<uint32_t>(diff);
+
+            if (diff < 0) {
+                // q_hat    :   
+                --q_hat;
+                uint64_t add_carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t sum = static_cast<uint64_t>(u[i + j]) + v[i] + add_carry;
+                    u[i + j] = static_cast<uint32_t>(sum);
+                    add_carry = sum >> 32;
+                }
+                u[j + n] = static_cast<uint32_t>(u[j + n] + add_carry);
+            }
+            quotient[j] = static_cast<uint32_t>(q_hat);
+        }
+        Trim(quotient);
+        return quotient;
+    }
+
+    BigInt operator+(const BigInt& lhs, const BigInt& rhs) {
+        if (lhs.negative_ == rhs.negative_) {
+            return BigInt(lhs.negative_, BigInt::AddMagnitudes(lhs.magnitude_, rhs.magnitude_));
+        }
+        if (BigInt::CompareMagnitudes(lhs.magnitude_, rhs.magnitude_) >= 0) {
+            return BigInt(lhs.negative_, BigInt::SubMagnitudes(lhs.magnitude_, rhs.magnitude_));
+        }
+        return BigInt(rhs.negative_, BigInt::SubMagnitudes(rhs.magnitude_, lhs.magnitude_));
+    }
+
+    BigInt operator-(const BigInt& lhs, const BigInt& rhs) {
+        return lhs + (-rhs);
+    }
+
+    BigInt operator*(const BigInt& lhs, const BigInt& rhs) {
+        return BigInt(lhs.negative_ != rhs.negative_, BigInt::MulMagnitudes(lhs.magnitude_, rhs.magnitude_));
+    }
+
+    BigInt operator/(const BigInt& lhs, const BigInt& rhs) {
+        if (rhs.IsZero()) {
+            throw runtime_error("Zero division"s);
+        }
+        return BigInt(lhs.negative_ != rhs.negative_, BigInt::DivMagnitudes(lhs.magnitude_, rhs.magnitude_));
+    }
+
+    bool operator==(const BigInt& lhs, const BigInt& rhs) {
+        return lhs.negative_ == rhs.negative_ && lhs.magnitude_ == rhs.magnitude_;
+    }
+
+    bool operator<(const BigInt& lhs, const BigInt& rhs) {
+        if (lhs.negative_ != rhs.negative_) {
+            return lhs.negative_;
+        }
+        const int cmp = BigInt::CompareMagnitudes(lhs.magnitude_, rhs.magnitude_);
+        return lhs.negative_ ? cmp > 0 : cmp < 0;
+    }
+
+    bool operator!=(const BigInt& lhs, const BigInt& rhs) {
+        return !(lhs == rhs);
+    }
+
+    ostream& operator<<(ostream& os, const BigInt& value) {
+        return os << value.ToString();
+    }
+
+    bool IsInteger(const ObjectHolder& object) {
+        return object.TryAs<Number>() != nullptr || object.TryAs<BigNumber>() != nullptr;
+    }
+
+    BigInt ToBigInt(const ObjectHolder& object) {
+        if (const auto* number = object.TryAs<Number>()) {
+            return BigInt(number->GetValue());
+        }
+        if (const auto* big_number = object.TryAs<BigNumber>()) {
+            return big_number->GetValue();
+        }
+        throw runtime_error("Integer expected"s);
+    }
+
+    ObjectHolder MakeInteger(const BigInt& value) {
+        if (value.FitsInt64()) {
+            return ObjectHolder::Own(Number{ value.ToInt64() });
+        }
+        return ObjectHolder::Own(BigNumber{ value });
+    }
+
+    ObjectHolder IntegerAdd(const ObjectHolder& lhs, const ObjectHolder& rhs) {
+        return MakeInteger(ToBigInt(lhs) + ToBigInt(rhs));
+    }
+
+    ObjectHolder IntegerSub(const ObjectHolder& lhs, const ObjectHolder& rhs) {
+        return MakeInteger(ToBigInt(lhs) - ToBigInt(rhs));
+    }
+
+    ObjectHolder IntegerMult(const ObjectHolder& lhs, const ObjectHolder& rhs) {
+        return MakeInteger(ToBigInt(lhs) * ToBigInt(rhs));
+    }
+
+    ObjectHolder IntegerDiv(const ObjectHolder& lhs, const ObjectHolder& rhs) {
+        return MakeInteger(ToBigInt(lhs) / ToBigInt(rhs));
+    }
+
+}  // namespace runtime
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "runtime.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace runtime {
+
+    /*
+     *    :      32- 
+     * (  ,   ).    ,
+     *     -   .  -    
+     */
+    class BigInt {
+    public:
+        BigInt() = default;
+        BigInt(int64_t value);  // NOLINT(google-explicit-constructor,hicpp-explicit-conversions)
+
+        //     (   )
+        static BigInt FromString(std::string_view decimal);
+
+        [[nodiscard]] bool IsZero() const;
+        [[nodiscard]] bool IsNegative() const;
+
+        //  true,     int64_t
+        [[nodiscard]] bool FitsInt64() const;
+        //   .      int64_t
+        [[nodiscard]] int64_t ToInt64() const;
+
+        //    
+        [[nodiscard]] std::string ToString() const;
+
+        BigInt operator-() const;
+
+        friend BigInt operator+(const BigInt& lhs, const BigInt& rhs);
+        friend BigInt operator-(const BigInt& lhs, const BigInt& rhs);
+        friend BigInt operator*(const BigInt& lhs, const BigInt& rhs);
+        //     .      runtime_error
+        friend BigInt operator/(const BigInt& lhs, const BigInt& rhs);
+
+        friend bool operator==(const BigInt& lhs, const BigInt& rhs);
+        friend bool operator<(const BigInt& lhs, const BigInt& rhs);
+
+    private:
+        using Limbs = std::vector<uint32_t>;
+
+        //           
+        static constexpr size_t KARATSUBA_THRESHOLD = 32;
+
+        BigInt(bool negative, Limbs magnitude);
+
+        static void Trim(Limbs& limbs);
+        static int CompareMagnitudes(const Limbs& lhs, const Limbs& rhs);
+        static Limbs AddMagnitudes(const Limbs& lhs, const Limbs& rhs);
+        //  rhs  lhs,  lhs      rhs
+        static Limbs SubMagnitudes(const Limbs& lhs, const Limbs& rhs);
+        static Limbs MulMagnitudes(const Limbs& lhs, const Limbs& rhs);
+        static Limbs SchoolbookMul(const Limbs& lhs, const Limbs& rhs);
+        static Limbs KaratsubaMul(const Limbs& lhs, const Limbs& rhs);
+        static Limbs DivMagnitudes(const Limbs& lhs, const Limbs& rhs);
+        //     ,  
+        static uint32_t DivBySmall(Limbs& limbs, uint32_t divisor);
+
+        bool negative_ = false;
+        Limbs magnitude_;
+    };
+
+    bool operator!=(const BigInt& lhs, const BigInt& rhs);
+    std::ostream& operator<<(std::ostream& os, const BigInt& value);
+
+    template <>
+    struct ValueTypeTag<BigInt> {
+        static constexpr TypeTag VALUE = TypeTag::BIG_NUMBER;
+    };
+
+    //   .    int64    Number
+    using BigNumber = ValueObject<BigInt>;
+
+    //  true,  object    (Number  BigNumber)
+    bool IsInteger(const ObjectHolder& object);
+
+    //     object   BigInt
+    BigInt ToBigInt(const ObjectHolder& object);
+
+    //  Number,  value   int64,  BigNumber   
+    ObjectHolder MakeInteger(const BigInt& value);
+
+    /*
+     *      ,      - BigNumber
+     *    Number    int64.     
+     */
+    ObjectHolder IntegerAdd(const ObjectHolder& lhs, const ObjectHolder& rhs);
+    ObjectHolder IntegerSub(const ObjectHolder& lhs, const ObjectHolder& rhs);
+    ObjectHolder IntegerMult(const ObjectHolder& lhs, const ObjectHolder& rhs);
+    ObjectHolder IntegerDiv(const ObjectHolder& lhs, const ObjectHolder& rhs);
+
+}  // namespace runtime
@@ -0,0 +1,230 @@
+#include "builtins.h"
+
+#include "bigint.h"
+#include "collections.h"
+
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace runtime {
+
+    namespace {
+        const std::string LEN_METHOD = "__len__"s;
+        const std::string SELF = "self"s;
+
+        InlineCache len_cache;
+
+        ObjectHolder MakeNumber(size_t value) {
+            return ObjectHolder::Own(Number{ static_cast<int64_t>(value) });
+        }
+
+        const ObjectHolder& IntegerArgument(const ObjectHolder& arg, const char* function) {
+            if (!IsInteger(arg)) {
+                throw runtime_error("Argument of "s + function + " must be an integer"s);
+            }
+            return arg;
+        }
+
+        ObjectHolder BuiltinLen(vector<ObjectHolder>& args, Context& context) {
+            return Length(args.front(), context);
+        }
+
+        // int(x):       ,  Bool   
+        ObjectHolder BuiltinInt(vector<ObjectHolder>& args, Context&) {
+            const ObjectHolder& arg = args.front();
+            switch (arg.GetTypeTag()) {
+            case TypeTag::NUMBER:
+            case TypeTag::BIG_NUMBER:
+                return arg;
+            case TypeTag::BOOL:
+                return ObjectHolder::Own(Number{ static_cast<const Bool&>(*arg).GetValue() ? 1 : 0 });
+            case TypeTag::STRING: {
+                const std::string& str = static_cast<const String&>(*arg).GetValue();
+                const size_t begin = str.find_first_not_of(" \t"sv);
+                const size_t end = str.find_last_not_of(" \t"sv);
+                if (begin == std::string::npos) {
+                    break;
+                }
+                const std::string_view digits = std::string_view(str).substr(begin, end - begin + 1);
+                const size_t first_digit = digits.front() == '-' || digits.front() == '+' ? 1 : 0;
+                if (digits.size() == first_digit) {
+                    break;
+                }
+                for (size_t i = first_digit; i < digits.size(); ++i) {
+                    if (!isdigit(static_cast<unsigned char>(digits[i]))) {
+                        throw runtime_error("Invalid literal for int(): "s + str);
+                    }
+                }
+                return MakeInteger(BigInt::FromString(digits.front() == '+' ? digits.substr(1) : digits));
+            }
+            default:
+                break;
+            }
+            throw runtime_error("Cannot convert to int"s);
+        }
+
+        ObjectHolder BuiltinAbs(vector<ObjectHolder>& args, Context&) {
+            const ObjectHolder& arg = IntegerArgument(args.front(), "abs");
+            if (arg.GetTypeTag() == TypeTag::NUMBER) {
+                const int64_t value = static_cast<const Number&>(*arg).GetValue();
+                if (value >= 0) {
+                    return arg;
+                }
+                if (value != numeric_limits<int64_t>::min()) {
+                    return ObjectHolder::Own(Number{ -value });
+                }
+            }
+            const BigInt value = ToBigInt(arg);
+            return value.IsNegative() ? MakeInteger(-value) : arg;
+        }
+
+        //   (better = Less)   (better = Greater) .
+        //   -  -   
+        ObjectHolder SelectExtremum(const vector<ObjectHolder>& args, Context& context,
+                                    bool (*better)(const ObjectHolder&, const ObjectHolder&, Context&)) {
+            if (args.size() == 1) {
+                auto iterator = MakeIterator(args.front(), context);
+                ObjectHolder result;
+                ObjectHolder item;
+                bool empty = true;
+                while (iterator->Next(item, context)) {
+                    if (empty || better(item, result, context)) {
+                        result = item;
+                    }
+                    empty = false;
+                }
+                if (empty) {
+                    throw runtime_error("Argument of min/max is an empty sequence"s);
+                }
+                return result;
+            }
+            const ObjectHolder* result = &args.front();
+            for (size_t i = 1; i < args.size(); ++i) {
+                if (better(args[i], *result, context)) {
+                    result = &args[i];
+                }
+            }
+            return *result;
+        }
+
+        ObjectHolder BuiltinMin(vector<ObjectHolder>& args, Context& context) {
+            return SelectExtremum(args, context, Less);
+        }
+
+        ObjectHolder BuiltinMax(vector<ObjectHolder>& args, Context& context) {
+            return SelectExtremum(args, context, Greater);
+        }
+
+        int64_t SmallIntegerArgument(const ObjectHolder& arg, const char* function) {
+            if (arg.GetTypeTag() != TypeTag::NUMBER) {
+                throw runtime_error("Argument of "s + function + " must be an integer"s);
+            }
+            return static_cast<const Number&>(*arg).GetValue();
+        }
+
+        // range(stop), range(start, stop), range(start, stop, step):    .
+        //     (. Range)
+        ObjectHolder BuiltinRange(vector<ObjectHolder>& args, Context&) {
+            int64_t start = 0;
+            int64_t stop = SmallIntegerArgument(args.front(), "range");
+            int64_t step = 1;
+            if (args.size() >= 2) {
+                start = stop;
+                stop = SmallIntegerArgument(args[1], "range");
+            }
+            if (args.size() == 3) {
+                step = SmallIntegerArgument(args[2], "range");
+            }
+            return ObjectHolder::Own(Range(start, stop, step));
+        }
+
+        // list(), list(sequence):     
+        ObjectHolder BuiltinList(vector<ObjectHolder>& args, Context& context) {
+            vector<ObjectHolder> items;
+            if (!args.empty()) {
+                if (args.front().GetTypeTag() == TypeTag::RANGE) {
+                    items.reserve(static_cast<const Range&>(*args.front()).Size());
+                }
+                auto iterator = MakeIterator(args.front(), context);
+                ObjectHolder item;
+                //   item ,      
+                while (iterator->Next(item, context)) {
+                    items.push_back(move(item));
+                }
+            }
+            return ObjectHolder::Own(List(move(items)));
+        }
+    }  // namespace
+
+    ObjectHolder Length(const ObjectHolder& object, Context& context) {
+        switch (object.GetTypeTag()) {
+        case TypeTag::LIST:
+            return MakeNumber(static_cast<const List&>(*object).Size());
+        case TypeTag::DICT:
+            return MakeNumber(static_cast<const Dict&>(*object).Size());
+        case TypeTag::STRING:
+            return MakeNumber(static_cast<const String&>(*object).GetValue().size());
+        case TypeTag::RANGE:
+            return MakeNumber(static_cast<const Range&>(*object).Size());
+        case TypeTag::INSTANCE: {
+            auto& instance = static_cast<ClassInstance&>(*object);
+            const Method* method = len_cache.Lookup(instance.GetClass(), LEN_METHOD);
+            if (method && method->formal_params.empty()) {
+                CallStack::Frame frame(context.GetCallStack());
+                frame->emplace(SELF, object);
+                return instance.CallInFrame(*method, *frame, context);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        throw runtime_error("Object has no len()"s);
+    }
+
+    BuiltinRegistry BuiltinRegistry::WithStandardFunctions() {
+        BuiltinRegistry registry;
+        registry.Register("len"s, BuiltinLen, 1);
+        registry.Register("int"s, BuiltinInt, 1);
+        registry.Register("abs"s, BuiltinAbs, 1);
+        registry.Register("min"s, BuiltinMin, 1, Builtin::VARIADIC);
+        registry.Register("max"s, BuiltinMax, 1, Builtin::VARIADIC);
+        registry.Register("range"s, BuiltinRange, 1, 3);
+        registry.Register("list"s, BuiltinList, 0, 1);
+        return registry;
+    }
+
+    const BuiltinRegistry& BuiltinRegistry::Standard() {
+        static const BuiltinRegistry registry = WithStandardFunctions();
+        return registry;
+    }
+
+    void BuiltinRegistry::Register(const std::string& name, NativeFunction function, size_t min_args, size_t max_args) {
+        if (!function || min_args > max_args) {
+            throw invalid_argument("Invalid builtin function "s + name);
+        }
+        functions_[name] = Builtin{ function, min_args, max_args };
+    }
+
+    const Builtin* BuiltinRegistry::Find(const std::string& name) const {
+        const auto it = functions_.find(name);
+        return it == functions_.end() ? nullptr : &it->second;
+    }
+
+    void BuiltinRegistry::RegisterClass(ObjectHolder cls) {
+        const auto* class_ptr = cls.TryAs<Class>();
+        if (!class_ptr) {
+            throw invalid_argument("Only classes can be registered"s);
+        }
+        classes_[class_ptr->GetName()] = move(cls);
+    }
+
+    const Class* BuiltinRegistry::FindClass(const std::string& name) const {
+        const auto it = classes_.find(name);
+        return it == classes_.end() ? nullptr : static_cast<const Class*>(it->second.Get());
+    }
+
+}  // namespace runtime
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "runtime.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace runtime {
+
+    //   Mython,   C++.     
+    using NativeFunction = ObjectHolder (*)(std::vector<ObjectHolder>& args, Context& context);
+
+    //   :       
+    struct Builtin {
+        static constexpr size_t VARIADIC = SIZE_MAX;
+
+        NativeFunction function = nullptr;
+        size_t min_args = 0;
+        size_t max_args = 0;
+
+        [[nodiscard]] bool AcceptsArgumentCount(size_t count) const {
+            return count >= min_args && count <= max_args;
+        }
+    };
+
+    /*
+     *   ,    name(args).
+     *     :      Builtin,
+     *        .     ,
+     *     
+     */
+    class BuiltinRegistry {
+    public:
+        //   
+        BuiltinRegistry() = default;
+
+        //     len, int, abs, min, max, range, list
+        static BuiltinRegistry WithStandardFunctions();
+
+        //     ,  ParseProgram  
+        static const BuiltinRegistry& Standard();
+
+        //   name,  .
+        //    min_args  max_args  (max_args = Builtin::VARIADIC -  )
+        void Register(const std::string& name, NativeFunction function, size_t min_args, size_t max_args);
+        void Register(const std::string& name, NativeFunction function, size_t arg_count) {
+            Register(name, function, arg_count, arg_count);
+        }
+
+        //   name  nullptr,    
+        [[nodiscard]] const Builtin* Find(const std::string& name) const;
+
+        //   (, , . NativeClassBuilder),  
+        //       . cls   runtime::Class
+        void RegisterClass(ObjectHolder cls);
+
+        //   name  nullptr,    
+        [[nodiscard]] const Class* FindClass(const std::string& name) const;
+
+    private:
+        //  unordered_map    ,    Find  
+        std::unordered_map<std::string, Builtin> functions_;
+        std::unordered_map<std::string, ObjectHolder> classes_;
+    };
+
+    /*
+     *   , ,   range    __len__  .
+     *     runtime_error
+     */
+    ObjectHolder Length(const ObjectHolder& object, Context& context);
+
+}  // namespace runtime
@@ -0,0 +1,794 @@
+#include "collections.h"
+
+#include "bigint.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace runtime {
+
+    void AppendRepr(const ObjectHolder& value, std::string& out, Context& context) {
+        switch (value.GetTypeTag()) {
+        case TypeTag::NONE:
+            out.append("None"sv);
+            break;
+        case TypeTag::STRING:
+            out.push_back('\'');
+            out.append(static_cast<const String&>(*value).GetValue());
+            out.push_back('\'');
+            break;
+        default:
+            value->AppendTo(out, context);
+        }
+    }
+
+    int64_t ToIndex(const ObjectHolder& index) {
+        if (index.GetTypeTag() != TypeTag::NUMBER) {
+            throw runtime_error("Indices must be integers"s);
+        }
+        return static_cast<const Number&>(*index).GetValue();
+    }
+
+    std::pair<size_t, size_t> SliceBounds(const ObjectHolder& start, const ObjectHolder& stop, size_t size) {
+        const auto length = static_cast<int64_t>(size);
+        auto clamp_bound = [length](const ObjectHolder& bound, int64_t default_value) {
+            if (!bound) {
+                return default_value;
+            }
+            int64_t value = ToIndex(bound);
+            if (value < 0) {
+                value += length;
+            }
+            return std::clamp<int64_t>(value, 0, length);
+        };
+        const int64_t begin = clamp_bound(start, 0);
+        const int64_t end = clamp_bound(stop, length);
+        return { static_cast<size_t>(begin), static_cast<size_t>(max(begin, end)) };
+    }
+
+    namespace {
+        const std::string& StringArgument(const ObjectHolder& arg, const std::string& method) {
+            if (arg.GetTypeTag() != TypeTag::STRING) {
+                throw runtime_error("Argument of str."s + method + " must be a string"s);
+            }
+            return static_cast<const String&>(*arg).GetValue();
+        }
+
+        /*
+         *  .       memchr ( glibc  ),
+         *       .      ,
+         *     memmem,     
+         */
+        int64_t FindSubstring(std::string_view str, std::string_view sub) {
+            if (sub.empty()) {
+                return 0;
+            }
+            constexpr int MAX_FALSE_CANDIDATES = 64;
+            const char* begin = str.data();
+            const char* end = str.data() + str.size();
+            const char* pos = begin;
+            for (int false_candidates = 0; static_cast<size_t>(end - pos) >= sub.size(); ++false_candidates) {
+                if (false_candidates == MAX_FALSE_CANDIDATES) {
+#ifdef __GLIBC__
+                    const void* found = memmem(pos, static_cast<size_t>(end - pos), sub.data(), sub.size());
+                    return found ? static_cast<const char*>(found) - begin : -1;
+#else
+                    const size_t found = str.find(sub, static_cast<size_t>(pos - begin));
+                    return found == std::string_view::npos ? -1 : static_cast<int64_t>(found);
+#endif
+                }
+                pos = static_cast<const char*>(memchr(pos, sub.front(), static_cast<size_t>(end - pos) - sub.size() + 1));
+                if (!pos) {
+                    break;
+                }
+                if (memcmp(pos + 1, sub.data() + 1, sub.size() - 1) == 0) {
+                    return pos - begin;
+                }
+                ++pos;
+            }
+            return -1;
+        }
+
+        ObjectHolder MakeString(std::string_view str) {
+            return ObjectHolder::Own(String{ std::string(str) });
+        }
+
+        ObjectHolder Split(std::string_view str, const ObjectHolder* separator, const std::string& method) {
+            std::vector<ObjectHolder> parts;
+            if (!separator) {
+                auto is_space = [](char c) {
+                    return isspace(static_cast<unsigned char>(c)) != 0;
+                };
+                size_t pos = 0;
+                while (true) {
+                    while (pos < str.size() && is_space(str[pos])) {
+                        ++pos;
+                    }
+                    if (pos == str.size()) {
+                        break;
+                    }
+                    const size_t start = pos;
+                    while (pos < str.size() && !is_space(str[pos])) {
+                        ++pos;
+                    }
+                    parts.push_back(MakeString(str.substr(start, pos - start)));
+                }
+                return ObjectHolder::Own(List(move(parts)));
+            }
+
+            const std::string& sep = StringArgument(*separator, method);
+            if (sep.empty()) {
+                throw runtime_error("Empty separator"s);
+            }
+            while (true) {
+                const int64_t pos = FindSubstring(str, sep);
+                if (pos < 0) {
+                    parts.push_back(MakeString(str));
+                    break;
+                }
+                parts.push_back(MakeString(str.substr(0, static_cast<size_t>(pos))));
+                str.remove_prefix(static_cast<size_t>(pos) + sep.size());
+            }
+            return ObjectHolder::Own(List(move(parts)));
+        }
+
+        ObjectHolder Join(const std::string& separator, const ObjectHolder& items, const std::string& method) {
+            if (items.GetTypeTag() != TypeTag::LIST) {
+                throw runtime_error("Argument of str.join must be a list"s);
+            }
+            const auto& list = static_cast<const List&>(*items).GetItems();
+            size_t total = list.empty() ? 0 : separator.size() * (list.size() - 1);
+            for (const ObjectHolder& item : list) {
+                total += StringArgument(item, method).size();
+            }
+            std::string result;
+            result.reserve(total);
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (i != 0) {
+                    result += separator;
+                }
+                result += static_cast<const String&>(*list[i]).GetValue();
+            }
+            return ObjectHolder::Own(String{ move(result) });
+        }
+    }  // namespace
+
+    ObjectHolder CallStringMethod(const std::string& str, const std::string& method, std::vector<ObjectHolder>& args) {
+        if (method == "find"sv && args.size() == 1) {
+            return ObjectHolder::Own(Number{ FindSubstring(str, StringArgument(args.front(), method)) });
+        }
+        if (method == "startswith"sv && args.size() == 1) {
+            const std::string& prefix = StringArgument(args.front(), method);
+            return MakeBool(str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0);
+        }
+        if (method == "endswith"sv && args.size() == 1) {
+            const std::string& suffix = StringArgument(args.front(), method);
+            return MakeBool(str.size() >= suffix.size()
+                            && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+        }
+        if (method == "split"sv && args.size() <= 1) {
+            return Split(str, args.empty() ? nullptr : &args.front(), method);
+        }
+        if (method == "join"sv && args.size() == 1) {
+            return Join(str, args.front(), method);
+        }
+        if ((method == "upper"sv || method == "lower"sv) && args.empty()) {
+            std::string result = str;
+            const bool upper = method == "upper"sv;
+            for (char& c : result) {
+                const auto code = static_cast<unsigned char>(c);
+                if (code < 0x80) {
+                    c = static_cast<char>(upper ? toupper(code) : tolower(code));
+                }
+            }
+            return ObjectHolder::Own(String{ move(result) });
+        }
+        throw runtime_error("String has no method "s + method + " taking "s + to_string(args.size()) + " arguments"s);
+    }
+
+    List::List(std::vector<ObjectHolder> items)
+        : items_(move(items))
+    {
+    }
+
+    List::~List() {
+        for (ObjectHolder& item : items_) {
+            Release(item);
+        }
+    }
+
+    void List::Print(std::ostream& os, Context& context) {
+        std::string text;
+        AppendTo(text, context);
+        os << text;
+    }
+
+    void List::AppendTo(std::string& out, Context& context) {
+        CheckNativeStack();
+        if (printing_) {
+            out.append("[...]"sv);
+            return;
+        }
+        printing_ = true;
+        try {
+            out.push_back('[');
+            // __str__    ,      ,
+            //     
+            for (size_t i = 0; i < items_.size(); ++i) {
+                const ObjectHolder item = items_[i];
+                if (i > 0) {
+                    out.append(", "sv);
+                }
+                AppendRepr(item, out, context);
+            }
+            out.push_back(']');
+        }
+        catch (...) {
+            printing_ = false;
+            throw;
+        }
+        printing_ = false;
+    }
+
+    TypeTag List::GetTypeTag() const {
+        return TypeTag::LIST;
+    }
+
+    size_t List::Size() const {
+        return items_.size();
+    }
+
+    const std::vector<ObjectHolder>& List::GetItems() const {
+        return items_;
+    }
+
+    size_t List::ToPosition(int64_t index) const {
+        const auto size = static_cast<int64_t>(items_.size());
+        if (index < 0) {
+            index += size;
+        }
+        if (index < 0 || index >= size) {
+            throw runtime_error("List index out of range"s);
+        }
+        return static_cast<size_t>(index);
+    }
+
+    ObjectHolder& List::At(int64_t index) {
+        return items_[ToPosition(index)];
+    }
+
+    void List::Append(ObjectHolder value) {
+        items_.push_back(move(value));
+    }
+
+    ObjectHolder List::Pop(int64_t index) {
+        if (items_.empty()) {
+            throw runtime_error("Pop from empty list"s);
+        }
+        const size_t position = ToPosition(index);
+        ObjectHolder result = move(items_[position]);
+        items_.erase(items_.begin() + static_cast<ptrdiff_t>(position));
+        return result;
+    }
+
+    ObjectHolder List::CallMethod(const std::string& method, std::vector<ObjectHolder>& args) {
+        if (method == "append"sv && args.size() == 1) {
+            Append(move(args.front()));
+            return {};
+        }
+        if (method == "pop"sv && args.size() <= 1) {
+            return Pop(args.empty() ? -1 : ToIndex(args.front()));
+        }
+        throw runtime_error("List has no method "s + method + " taking "s + to_string(args.size()) + " arguments"s);
+    }
+
+    void List::Traverse(const std::function<void(const ObjectHolder&)>& visitor) const {
+        for (const ObjectHolder& item : items_) {
+            visitor(item);
+        }
+    }
+
+    void List::ClearReferences() {
+        items_.clear();
+    }
+
+    namespace {
+        //    (  Number  BigNumber)  ,  
+        //       ==
+        bool KeysEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
+            const TypeTag lhs_tag = lhs.GetTypeTag();
+            const TypeTag rhs_tag = rhs.GetTypeTag();
+            if (lhs_tag != rhs_tag) {
+                return IsInteger(lhs) && IsInteger(rhs) && Equal(lhs, rhs, context);
+            }
+            if (lhs.Get() == rhs.Get()) {
+                return true;
+            }
+            return Equal(lhs, rhs, context);
+        }
+    }  // namespace
+
+    Dict::~Dict() {
+        for (Entry& entry : entries_) {
+            Release(entry.key);
+            Release(entry.value);
+        }
+    }
+
+    void Dict::Print(std::ostream& os, Context& context) {
+        std::string text;
+        AppendTo(text, context);
+        os << text;
+    }
+
+    void Dict::AppendTo(std::string& out, Context& context) {
+        CheckNativeStack();
+        if (printing_) {
+            out.append("{...}"sv);
+            return;
+        }
+        printing_ = true;
+        try {
+            out.push_back('{');
+            bool first = true;
+            // __str__      ,   
+            //  ,       
+            for (size_t i = 0; i < entries_.size(); ++i) {
+                if (!entries_[i].alive) {
+                    continue;
+                }
+                const ObjectHolder key = entries_[i].key;
+                const ObjectHolder value = entries_[i].value;
+                if (!first) {
+                    out.append(", "sv);
+                }
+                first = false;
+                AppendRepr(key, out, context);
+                out.append(": "sv);
+                AppendRepr(value, out, context);
+            }
+            out.push_back('}');
+        }
+        catch (...) {
+            printing_ = false;
+            throw;
+        }
+        printing_ = false;
+    }
+
+    TypeTag Dict::GetTypeTag() const {
+        return TypeTag::DICT;
+    }
+
+    size_t Dict::Size() const {
+        return size_;
+    }
+
+    size_t Dict::Distance(size_t position, uint32_t hash) const {
+        return (position - hash) & (index_.size() - 1);
+    }
+
+    size_t Dict::FindBucket(const ObjectHolder& key, size_t hash, Context& context) const {
+        if (index_.empty()) {
+            return 0;
+        }
+        const size_t capacity = index_.size();
+        const size_t mask = capacity - 1;
+        const uint64_t version = version_;
+        const auto short_hash = static_cast<uint32_t>(hash);
+        for (size_t position = hash & mask, distance = 0;; position = (position + 1) & mask, ++distance) {
+            const Bucket bucket = index_[position];
+            if (bucket.entry == EMPTY || Distance(position, bucket.hash) < distance) {
+                return capacity;
+            }
+            if (bucket.hash != short_hash) {
+                continue;
+            }
+            // __eq__    ,   ,   
+            // ,    
+            const ObjectHolder stored_key = entries_[bucket.entry].key;
+            const bool equal = KeysEqual(stored_key, key, context);
+            if (version_ != version || index_.size() != capacity) {
+                throw runtime_error("Dict changed during lookup"s);
+            }
+            if (equal) {
+                return position;
+            }
+        }
+    }
+
+    ObjectHolder* Dict::Find(const ObjectHolder& key, Context& context) {
+        const size_t position = FindBucket(key, Hash(key, context), context);
+        if (position >= index_.size()) {
+            return nullptr;
+        }
+        return &entries_[index_[position].entry].value;
+    }
+
+    ObjectHolder& Dict::At(const ObjectHolder& key, Context& context) {
+        ObjectHolder* value = Find(key, context);
+        if (!value) {
+            std::string message = "Key not found: "s;
+            AppendRepr(key, message, context);
+            throw runtime_error(message);
+        }
+        return *value;
+    }
+
+    void Dict::InsertBucket(Bucket bucket) {
+        const size_t mask = index_.size() - 1;
+        size_t position = bucket.hash & mask;
+        size_t distance = 0;
+        while (index_[position].entry != EMPTY) {
+            const size_t existing_distance = Distance(position, index_[position].hash);
+            if (existing_distance < distance) {
+                std::swap(bucket, index_[position]);
+                distance = existing_distance;
+            }
+            position = (position + 1) & mask;
+            ++distance;
+        }
+        index_[position] = bucket;
+    }
+
+    void Dict::Rehash(size_t capacity) {
+        if (size_ != entries_.size()) {
+            entries_.erase(remove_if(entries_.begin(), entries_.end(), [](const Entry& entry) {
+                return !entry.alive;
+            }), entries_.end());
+        }
+        index_.assign(capacity, Bucket{});
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            InsertBucket({ static_cast<uint32_t>(i), static_cast<uint32_t>(entries_[i].hash) });
+        }
+    }
+
+    ObjectHolder& Dict::Set(ObjectHolder key, ObjectHolder value, Context& context) {
+        const size_t hash = Hash(key, context);
+        const size_t position = FindBucket(key, hash, context);
+        if (position < index_.size()) {
+            ObjectHolder& stored = entries_[index_[position].entry].value;
+            stored = move(value);
+            return stored;
+        }
+        //       7/8,   -    .
+        //     
+        if ((entries_.size() + 1) * 8 > index_.size() * 7) {
+            size_t capacity = MIN_CAPACITY;
+            while ((size_ + 1) * 2 > capacity) {
+                capacity *= 2;
+            }
+            Rehash(capacity);
+        }
+        if (entries_.size() >= EMPTY) {
+            throw runtime_error("Dict is too large"s);
+        }
+        entries_.push_back({ move(key), move(value), hash, true });
+        InsertBucket({ static_cast<uint32_t>(entries_.size() - 1), static_cast<uint32_t>(hash) });
+        ++size_;
+        ++version_;
+        return entries_.back().value;
+    }
+
+    bool Dict::Erase(const ObjectHolder& key, Context& context) {
+        size_t position = FindBucket(key, Hash(key, context), context);
+        if (position >= index_.size()) {
+            return false;
+        }
+        Entry& entry = entries_[index_[position].entry];
+        entry.alive = false;
+        //   ,    
+        entry.key = {};
+        entry.value = {};
+        --size_;
+        ++version_;
+
+        //    ,       
+        const size_t mask = index_.size() - 1;
+        size_t next = (position + 1) & mask;
+        while (index_[next].entry != EMPTY && Distance(next, index_[next].hash) != 0) {
+            index_[position] = index_[next];
+            position = next;
+            next = (next + 1) & mask;
+        }
+        index_[position] = Bucket{};
+        return true;
+    }
+
+    void Dict::ForEach(const std::function<void(const ObjectHolder&, const ObjectHolder&)>& func) const {
+        for (const Entry& entry : entries_) {
+            if (entry.alive) {
+                func(entry.key, entry.value);
+            }
+        }
+    }
+
+    const ObjectHolder* Dict::NextKey(size_t& position) const {
+        while (position < entries_.size()) {
+            const Entry& entry = entries_[position++];
+            if (entry.alive) {
+                return &entry.key;
+            }
+        }
+        return nullptr;
+    }
+
+    ObjectHolder Dict::CallMethod(const std::string& method, std::vector<ObjectHolder>& args, Context& context) {
+        if (method == "get"sv && (args.size() == 1 || args.size() == 2)) {
+            const ObjectHolder* value = Find(args.front(), context);
+            if (value) {
+                return *value;
+            }
+            return args.size() == 2 ? args.back() : ObjectHolder::None();
+        }
+        if (method == "pop"sv && args.size() == 1) {
+            ObjectHolder value = At(args.front(), context);
+            Erase(args.front(), context);
+            return value;
+        }
+        if ((method == "keys"sv || method == "values"sv) && args.empty()) {
+            const bool keys = method == "keys"sv;
+            std::vector<ObjectHolder> items;
+            items.reserve(size_);
+            ForEach([&items, keys](const ObjectHolder& key, const ObjectHolder& value) {
+                items.push_back(keys ? key : value);
+            });
+            return ObjectHolder::Own(List(move(items)));
+        }
+        throw runtime_error("Dict has no method "s + method + " taking "s + to_string(args.size()) + " arguments"s);
+    }
+
+    void Dict::Traverse(const std::function<void(const ObjectHolder&)>& visitor) const {
+        for (const Entry& entry : entries_) {
+            visitor(entry.key);
+            visitor(entry.value);
+        }
+    }
+
+    void Dict::ClearReferences() {
+        entries_.clear();
+        index_.clear();
+        size_ = 0;
+    }
+
+    Range::Range(int64_t start, int64_t stop, int64_t step)
+        : start_(start)
+        , stop_(stop)
+        , step_(step)
+        , size_(0)
+    {
+        if (step == 0) {
+            throw runtime_error("Step of range must not be zero"s);
+        }
+        //       int64
+        const __int128 distance = step > 0 ? static_cast<__int128>(stop) - start : static_cast<__int128>(start) - stop;
+        const __int128 abs_step = step > 0 ? static_cast<__int128>(step) : -static_cast<__int128>(step);
+        if (distance > 0) {
+            size_ = static_cast<uint64_t>((distance - 1) / abs_step + 1);
+        }
+    }
+
+    void Range::Print(std::ostream& os, [[maybe_unused]] Context& context) {
+        os << "range("sv << start_ << ", "sv << stop_;
+        if (step_ != 1) {
+            os << ", "sv << step_;
+        }
+        os << ')';
+    }
+
+    TypeTag Range::GetTypeTag() const {
+        return TypeTag::RANGE;
+    }
+
+    int64_t Range::GetStart() const {
+        return start_;
+    }
+
+    int64_t Range::GetStop() const {
+        return stop_;
+    }
+
+    int64_t Range::GetStep() const {
+        return step_;
+    }
+
+    uint64_t Range::Size() const {
+        return size_;
+    }
+
+    int64_t Range::At(int64_t index) const {
+        const __int128 position = index < 0 ? static_cast<__int128>(size_) + index : static_cast<__int128>(index);
+        if (position < 0 || position >= static_cast<__int128>(size_)) {
+            throw runtime_error("Range index out of range"s);
+        }
+        return static_cast<int64_t>(start_ + position * step_);
+    }
+
+    namespace {
+        const std::string ITER_METHOD = "__iter__"s;
+        const std::string NEXT_METHOD = "__next__"s;
+
+        void AssignNumber(ObjectHolder& slot, int64_t value) {
+            if (slot.GetTypeTag() == TypeTag::NUMBER && slot.IsUnique()) {
+                static_cast<Number&>(*slot).GetMutableValue() = value;
+            }
+            else {
+                slot = ObjectHolder::Own(Number{ value });
+            }
+        }
+
+        class ListIterator : public Iterator {
+        public:
+            explicit ListIterator(ObjectHolder list)
+                : holder_(move(list))
+                , list_(static_cast<const List&>(*holder_))
+            {}
+
+            //     :     
+            bool Next(ObjectHolder& slot, Context&) override {
+                if (position_ >= list_.Size()) {
+                    return false;
+                }
+                slot = list_.GetItems()[position_++];
+                return true;
+            }
+
+        private:
+            ObjectHolder holder_;
+            const List& list_;
+            size_t position_ = 0;
+        };
+
+        class RangeIterator : public Iterator {
+        public:
+            explicit RangeIterator(const Range& range)
+                : current_(range.GetStart())
+                , step_(range.GetStep())
+                , remaining_(range.Size())
+            {}
+
+            bool Next(ObjectHolder& slot, Context&) override {
+                if (remaining_ == 0) {
+                    return false;
+                }
+                AssignNumber(slot, current_);
+                //      ,  current_  
+                if (--remaining_ > 0) {
+                    current_ += step_;
+                }
+                return true;
+            }
+
+        private:
+            int64_t current_;
+            int64_t step_;
+            uint64_t remaining_;
+        };
+
+        class StringIterator : public Iterator {
+        public:
+            explicit StringIterator(ObjectHolder str)
+                : holder_(move(str))
+                , str_(static_cast<const String&>(*holder_).GetValue())
+            {}
+
+            bool Next(ObjectHolder& slot, Context&) override {
+                if (position_ >= str_.size()) {
+                    return false;
+                }
+                const char c = str_[position_++];
+                if (slot.GetTypeTag() == TypeTag::STRING && slot.IsUnique()) {
+                    static_cast<String&>(*slot).GetMutableValue().assign(1, c);
+                }
+                else {
+                    slot = ObjectHolder::Own(String{ std::string(1, c) });
+                }
+                return true;
+            }
+
+        private:
+            ObjectHolder holder_;
+            const std::string& str_;
+            size_t position_ = 0;
+        };
+
+        class DictIterator : public Iterator {
+        public:
+            explicit DictIterator(ObjectHolder dict)
+                : holder_(move(dict))
+                , dict_(static_cast<const Dict&>(*holder_))
+                , version_(dict_.GetVersion())
+            {}
+
+            //   :      ,
+            //       position_
+            bool Next(ObjectHolder& slot, Context&) override {
+                if (dict_.GetVersion() != version_) {
+                    throw runtime_error("Dict changed during iteration"s);
+                }
+                const ObjectHolder* key = dict_.NextKey(position_);
+                if (!key) {
+                    return false;
+                }
+                slot = *key;
+                return true;
+            }
+
+        private:
+            ObjectHolder holder_;
+            const Dict& dict_;
+            uint64_t version_;
+            size_t position_ = 0;
+        };
+
+        //      __next__.       
+        class InstanceIterator : public Iterator {
+        public:
+            InstanceIterator(ObjectHolder instance, const Method& next)
+                : holder_(move(instance))
+                , instance_(static_cast<ClassInstance&>(*holder_))
+                , next_(next)
+            {}
+
+            bool Next(ObjectHolder& slot, Context& context) override {
+                ObjectHolder item = instance_.Call(next_, {}, context);
+                if (!item) {
+                    return false;
+                }
+                slot = move(item);
+                return true;
+            }
+
+        private:
+            ObjectHolder holder_;
+            ClassInstance& instance_;
+            const Method& next_;
+        };
+
+        std::unique_ptr<Iterator> MakeBuiltinIterator(const ObjectHolder& iterable) {
+            switch (iterable.GetTypeTag()) {
+            case TypeTag::LIST:
+                return make_unique<ListIterator>(iterable);
+            case TypeTag::RANGE:
+                return make_unique<RangeIterator>(static_cast<const Range&>(*iterable));
+            case TypeTag::STRING:
+                return make_unique<StringIterator>(iterable);
+            case TypeTag::DICT:
+                return make_unique<DictIterator>(iterable);
+            default:
+                return nullptr;
+            }
+        }
+
+        const Method* FindMethodWithoutArguments(const ObjectHolder& object, const std::string& name) {
+            if (object.GetTypeTag() != TypeTag::INSTANCE) {
+                return nullptr;
+            }
+            const Method* method = static_cast<const ClassInstance&>(*object).GetClass().GetMethod(name);
+            return method && method->formal_params.empty() ? method : nullptr;
+        }
+    }  // namespace
+
+    std::unique_ptr<Iterator> MakeIterator(const ObjectHolder& iterable, Context& context) {
+        if (auto iterator = MakeBuiltinIterator(iterable)) {
+            return iterator;
+        }
+        if (const Method* iter = FindMethodWithoutArguments(iterable, ITER_METHOD)) {
+            ObjectHolder result = static_cast<ClassInstance&>(*iterable).Call(*iter, {}, context);
+            if (auto iterator = MakeBuiltinIterator(result)) {
+                return iterator;
+            }
+            if (const Method* next = FindMethodWithoutArguments(result, NEXT_METHOD)) {
+                return make_unique<InstanceIterator>(move(result), *next);
+            }
+            throw runtime_error("Method __iter__ must return a sequence or an object with __next__()"s);
+        }
+        throw runtime_error("Object is not iterable"s);
+    }
+
+}  // namespace runtime
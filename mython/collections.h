@@ -0,0 +1,237 @@
+#pragma once
+
+#include "runtime.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+    //   out  ,     :  -  ,   - None
+    void AppendRepr(const ObjectHolder& value, std::string& out, Context& context);
+
+    /*
+     *  Mython.     std::vector:    
+     *  O(1),    -   O(1).
+     *      ,    
+     */
+    class List : public GcObject {
+    public:
+        List() = default;
+        explicit List(std::vector<ObjectHolder> items);
+        List(const List&) = default;
+        List(List&&) = default;
+        ~List() override;
+
+        //      [1, 'a', None]
+        void Print(std::ostream& os, Context& context) override;
+        void AppendTo(std::string& out, Context& context) override;
+
+        [[nodiscard]] TypeTag GetTypeTag() const override;
+
+        [[nodiscard]] size_t Size() const;
+        [[nodiscard]] const std::vector<ObjectHolder>& GetItems() const;
+
+        //     index.      .
+        //       runtime_error
+        [[nodiscard]] ObjectHolder& At(int64_t index);
+
+        void Append(ObjectHolder value);
+
+        //         index.
+        //       runtime_error
+        ObjectHolder Pop(int64_t index);
+
+        /*
+         *    :
+         *   append(value) -  value   ,  None
+         *   pop([index])  -     index (  )
+         *        runtime_error
+         */
+        ObjectHolder CallMethod(const std::string& method, std::vector<ObjectHolder>& args);
+
+        void Traverse(const std::function<void(const ObjectHolder&)>& visitor) const override;
+        void ClearReferences() override;
+
+    private:
+        [[nodiscard]] size_t ToPosition(int64_t index) const;
+
+        std::vector<ObjectHolder> items_;
+        //    ,  ,   ,   [...]
+        bool printing_ = false;
+    };
+
+    /*
+     *  Mython.    , ,  Bool, None   
+     *   __hash__  __eq__.
+     *
+     *         entries_,    
+     * -    index_,         .
+     *     Robin Hood:       , 
+     *      .     ,  
+     *   ,       .
+     *    (  __eq__) ,      
+     */
+    class Dict : public GcObject {
+    public:
+        Dict() = default;
+        Dict(const Dict&) = default;
+        Dict(Dict&&) = default;
+        ~Dict() override;
+
+        //         {'a': 1, 2: None}
+        void Print(std::ostream& os, Context& context) override;
+        void AppendTo(std::string& out, Context& context) override;
+
+        [[nodiscard]] TypeTag GetTypeTag() const override;
+
+        [[nodiscard]] size_t Size() const;
+
+        //     :        .
+        //    ,   ,    
+        [[nodiscard]] uint64_t GetVersion() const {
+            return version_;
+        }
+
+        //       key  nullptr,    
+        [[nodiscard]] ObjectHolder* Find(const ObjectHolder& key, Context& context);
+
+        //     key   runtime_error,    
+        [[nodiscard]] ObjectHolder& At(const ObjectHolder& key, Context& context);
+
+        //   value  key,     .
+        //     
+        ObjectHolder& Set(ObjectHolder key, ObjectHolder value, Context& context);
+
+        //   key.  false,     
+        bool Erase(const ObjectHolder& key, Context& context);
+
+        //  func(key, value)      
+        void ForEach(const std::function<void(const ObjectHolder&, const ObjectHolder&)>& func) const;
+
+        //    ,    position   ,   position
+        //     .    ,  nullptr
+        [[nodiscard]] const ObjectHolder* NextKey(size_t& position) const;
+
+        /*
+         *    :
+         *   get(key[, default]) -    key  default (  None)
+         *   pop(key)            -      
+         *   keys(), values()    -       
+         *   ,       runtime_error
+         */
+        ObjectHolder CallMethod(const std::string& method, std::vector<ObjectHolder>& args, Context& context);
+
+        void Traverse(const std::function<void(const ObjectHolder&)>& visitor) const override;
+        void ClearReferences() override;
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+        static constexpr size_t MIN_CAPACITY = 8;
+
+        struct Entry {
+            ObjectHolder key;
+            ObjectHolder value;
+            size_t hash = 0;
+            bool alive = true;
+        };
+
+        //  -:    entries_   32   
+        struct Bucket {
+            uint32_t entry = EMPTY;
+            uint32_t hash = 0;
+        };
+
+        //      key  index_  index_.size(),   
+        [[nodiscard]] size_t FindBucket(const ObjectHolder& key, size_t hash, Context& context) const;
+        //     bucket,     
+        void InsertBucket(Bucket bucket);
+        //    capacity ,   entries_  
+        void Rehash(size_t capacity);
+        [[nodiscard]] size_t Distance(size_t position, uint32_t hash) const;
+
+        std::vector<Entry> entries_;
+        std::vector<Bucket> index_;
+        size_t size_ = 0;
+        uint64_t version_ = 0;
+        bool printing_ = false;
+    };
+
+    /*
+     *  range(start, stop, step) -    start  stop ( )   step.
+     *         ,    
+     *    
+     */
+    class Range : public Object {
+    public:
+        //  step     
+        Range(int64_t start, int64_t stop, int64_t step);
+
+        //    ,  Python: range(0, 5)  range(1, 7, 2)
+        void Print(std::ostream& os, Context& context) override;
+
+        [[nodiscard]] TypeTag GetTypeTag() const override;
+
+        [[nodiscard]] int64_t GetStart() const;
+        [[nodiscard]] int64_t GetStop() const;
+        [[nodiscard]] int64_t GetStep() const;
+        [[nodiscard]] uint64_t Size() const;
+
+        //     index.      .
+        //       runtime_error
+        [[nodiscard]] int64_t At(int64_t index) const;
+
+    private:
+        int64_t start_;
+        int64_t stop_;
+        int64_t step_;
+        uint64_t size_;
+    };
+
+    /*
+     *    ,   for.
+     * Next     slot.  slot -    Number  String,
+     *       , , ,    range
+     *       
+     */
+    class Iterator {
+    public:
+        virtual ~Iterator() = default;
+
+        //   slot     true.   ,  false
+        virtual bool Next(ObjectHolder& slot, Context& context) = 0;
+    };
+
+    /*
+     *     iterable: , range,  ( ),
+     *  (    )      __iter__().
+     * __iter__         __next__();
+     *     ,  __next__  None.
+     *           , Next  runtime_error.
+     *     runtime_error
+     */
+    std::unique_ptr<Iterator> MakeIterator(const ObjectHolder& iterable, Context& context);
+
+    //       runtime_error
+    int64_t ToIndex(const ObjectHolder& index);
+
+    /*
+     *    [start:stop]      size  ,  Python:
+     *     ,    -   .
+     *  ObjectHolder     .   [begin, end)
+     */
+    std::pair<size_t, size_t> SliceBounds(const ObjectHolder& start, const ObjectHolder& stop, size_t size);
+
+    /*
+     *     str:
+     *   find(sub)       -    sub  -1
+     *   startswith(p), endswith(s)
+     *   split([sep])    -  ,  sep;   -   
+     *   join(list)      -   list,   str
+     *   upper(), lower() -         
+     *        runtime_error
+     */
+    ObjectHolder CallStringMethod(const std::string& str, const std::string& method, std::vector<ObjectHolder>& args);
+
+}  // namespace runtime
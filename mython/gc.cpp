@@ -0,0 +1,256 @@
+#include "gc.h"
+
+#include <limits>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace runtime {
+
+    GcObject::GcObject() {
+        CycleCollector::Current().Track(*this);
+    }
+
+    GcObject::GcObject(const GcObject& /*other*/)
+        : GcObject()
+    {
+    }
+
+    GcObject::GcObject(GcObject&& /*other*/) noexcept
+        : GcObject()
+    {
+    }
+
+    GcObject::~GcObject() {
+        if (collector_) {
+            collector_->Untrack(*this);
+        }
+    }
+
+    namespace {
+        //  ,       GcObject::Release
+        thread_local vector<ObjectHolder>* release_queue = nullptr;
+
+        bool IsContainer(const ObjectHolder& holder) {
+            const TypeTag tag = holder.GetTypeTag();
+            return tag == TypeTag::LIST || tag == TypeTag::DICT || tag == TypeTag::INSTANCE;
+        }
+    }  // namespace
+
+    void GcObject::Release(ObjectHolder& holder) noexcept {
+        if (!holder.IsUnique() || !IsContainer(holder)) {
+            holder = ObjectHolder();
+            return;
+        }
+        try {
+            if (release_queue) {
+                release_queue->push_back(std::move(holder));
+                return;
+            }
+            vector<ObjectHolder> queue;
+            queue.push_back(std::move(holder));
+            release_queue = &queue;
+            while (!queue.empty()) {
+                //        
+                ObjectHolder next = std::move(queue.back());
+                queue.pop_back();
+                next = ObjectHolder();
+            }
+            release_queue = nullptr;
+        } catch (const bad_alloc&) {
+            //       
+            holder = ObjectHolder();
+        }
+    }
+
+    CycleCollector::~CycleCollector() {
+        for (Generation& generation : generations_) {
+            for (GcObject* object = generation.head; object;) {
+                GcObject* next = object->next_;
+                object->collector_ = nullptr;
+                object->prev_ = object->next_ = nullptr;
+                object = next;
+            }
+        }
+    }
+
+    CycleCollector& CycleCollector::Current() {
+        thread_local CycleCollector collector;
+        return collector;
+    }
+
+    void CycleCollector::SetThresholds(const array<size_t, GENERATIONS>& thresholds) {
+        thresholds_ = thresholds;
+    }
+
+    const array<size_t, CycleCollector::GENERATIONS>& CycleCollector::GetThresholds() const {
+        return thresholds_;
+    }
+
+    void CycleCollector::SetEnabled(bool enabled) {
+        enabled_ = enabled;
+    }
+
+    bool CycleCollector::IsEnabled() const {
+        return enabled_;
+    }
+
+    const GcStats& CycleCollector::GetStats() const {
+        return stats_;
+    }
+
+    size_t CycleCollector::GetTrackedCount() const {
+        size_t result = 0;
+        for (const Generation& generation : generations_) {
+            result += generation.size;
+        }
+        return result;
+    }
+
+    void CycleCollector::Link(GcObject& object, size_t generation) {
+        Generation& list = generations_[generation];
+        object.generation_ = static_cast<uint8_t>(generation);
+        object.prev_ = nullptr;
+        object.next_ = list.head;
+        if (list.head) {
+            list.head->prev_ = &object;
+        }
+        list.head = &object;
+        ++list.size;
+    }
+
+    void CycleCollector::Unlink(GcObject& object) {
+        Generation& list = generations_[object.generation_];
+        if (object.prev_) {
+            object.prev_->next_ = object.next_;
+        }
+        else {
+            list.head = object.next_;
+        }
+        if (object.next_) {
+            object.next_->prev_ = object.prev_;
+        }
+        object.prev_ = object.next_ = nullptr;
+        --list.size;
+    }
+
+    void CycleCollector::Track(GcObject& object) {
+        object.collector_ = this;
+        Link(object, 0);
+        ++counts_[0];
+    }
+
+    void CycleCollector::Untrack(GcObject& object) {
+        Unlink(object);
+        if (counts_[0] > 0) {
+            --counts_[0];
+        }
+    }
+
+    void CycleCollector::MaybeCollect() {
+        if (!enabled_ || collecting_ || counts_[0] <= thresholds_[0]) {
+            return;
+        }
+        size_t generation = GENERATIONS - 1;
+        while (generation > 0 && counts_[generation] <= thresholds_[generation]) {
+            --generation;
+        }
+        Collect(generation);
+    }
+
+    size_t CycleCollector::Collect(size_t generation) {
+        if (collecting_) {
+            return 0;
+        }
+        collecting_ = true;
+        const auto start = chrono::steady_clock::now();
+        generation = min(generation, GENERATIONS - 1);
+
+        //  -    . gc_refs_    ;
+        // ,   shared_ptr (,   ),  
+        vector<GcObject*> candidates;
+        for (size_t gen = 0; gen <= generation; ++gen) {
+            for (GcObject* object = generations_[gen].head; object; object = object->next_) {
+                const long use_count = object->weak_from_this().use_count();
+                object->gc_refs_ = use_count > 0 ? static_cast<size_t>(use_count) : numeric_limits<size_t>::max();
+                object->collecting_ = true;
+                candidates.push_back(object);
+            }
+        }
+
+        auto as_candidate = [](const ObjectHolder& holder) -> GcObject* {
+            if (!holder || !holder.IsOwning()) {
+                return nullptr;
+            }
+            GcObject* object = dynamic_cast<GcObject*>(holder.Get());
+            return object && object->collecting_ ? object : nullptr;
+        };
+
+        //    :    
+        for (GcObject* object : candidates) {
+            object->Traverse([&as_candidate](const ObjectHolder& holder) {
+                if (GcObject* target = as_candidate(holder); target && target->gc_refs_ != numeric_limits<size_t>::max()) {
+                    --target->gc_refs_;
+                }
+            });
+        }
+
+        // ,       , 
+        vector<GcObject*> reachable;
+        for (GcObject* object : candidates) {
+            if (object->gc_refs_ > 0) {
+                object->collecting_ = false;
+                reachable.push_back(object);
+            }
+        }
+        while (!reachable.empty()) {
+            GcObject* object = reachable.back();
+            reachable.pop_back();
+            object->Traverse([&as_candidate, &reachable](const ObjectHolder& holder) {
+                if (GcObject* target = as_candidate(holder)) {
+                    target->collecting_ = false;
+                    reachable.push_back(target);
+                }
+            });
+        }
+
+        //     ,     
+        vector<shared_ptr<GcObject>> garbage;
+        const size_t next_generation = min(generation + 1, GENERATIONS - 1);
+        for (GcObject* object : candidates) {
+            if (object->collecting_) {
+                object->collecting_ = false;
+                garbage.push_back(object->shared_from_this());
+            }
+            else if (object->generation_ != next_generation) {
+                Unlink(*object);
+                Link(*object, next_generation);
+            }
+        }
+
+        for (const auto& object : garbage) {
+            object->ClearReferences();
+        }
+        const size_t collected = garbage.size();
+        garbage.clear();
+
+        counts_[0] = 0;
+        for (size_t gen = 1; gen <= generation; ++gen) {
+            counts_[gen] = 0;
+        }
+        if (generation + 1 < GENERATIONS) {
+            ++counts_[generation + 1];
+        }
+
+        const auto pause = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        ++stats_.collections[generation];
+        stats_.collected += collected;
+        stats_.last_pause = pause;
+        stats_.max_pause = max(stats_.max_pause, pause);
+        stats_.total_pause += pause;
+        collecting_ = false;
+        return collected;
+    }
+
+}  // namespace runtime
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "runtime.h"
+
+#include <array>
+#include <chrono>
+
+namespace runtime {
+
+    //    
+    struct GcStats {
+        //    
+        std::array<size_t, 3> collections{};
+        //   ,  
+        size_t collected = 0;
+        //    
+        std::chrono::nanoseconds last_pause{ 0 };
+        std::chrono::nanoseconds max_pause{ 0 };
+        std::chrono::nanoseconds total_pause{ 0 };
+    };
+
+    /*
+     *      GcObject.
+     *   Mython   ,     
+     * (, node.parent = p; p.child = node).     
+     * ,   CPython:       
+     * ,     . ,    
+     *            ,
+     *  :     ,     .
+     *
+     *     .      0, 
+     *    .  0 ,    
+     *  ,  i + 1 -     i  .
+     *     
+     */
+    class CycleCollector {
+    public:
+        static constexpr size_t GENERATIONS = 3;
+
+        CycleCollector() = default;
+        // ,   (,    ),
+        //  
+        ~CycleCollector();
+
+        CycleCollector(const CycleCollector&) = delete;
+        CycleCollector& operator=(const CycleCollector&) = delete;
+
+        //    
+        static CycleCollector& Current();
+
+        //     
+        void SetThresholds(const std::array<size_t, GENERATIONS>& thresholds);
+        [[nodiscard]] const std::array<size_t, GENERATIONS>& GetThresholds() const;
+
+        //       MaybeCollect
+        void SetEnabled(bool enabled);
+        [[nodiscard]] bool IsEnabled() const;
+
+        //  ,   .    ,
+        //       ObjectHolder
+        void MaybeCollect();
+
+        //    0  generation .    
+        size_t Collect(size_t generation = GENERATIONS - 1);
+
+        [[nodiscard]] const GcStats& GetStats() const;
+
+        //    
+        [[nodiscard]] size_t GetTrackedCount() const;
+
+    private:
+        friend class GcObject;
+
+        struct Generation {
+            GcObject* head = nullptr;
+            size_t size = 0;
+        };
+
+        void Track(GcObject& object);
+        void Untrack(GcObject& object);
+        void Link(GcObject& object, size_t generation);
+        void Unlink(GcObject& object);
+
+        std::array<Generation, GENERATIONS> generations_;
+        std::array<size_t, GENERATIONS> thresholds_{ 700, 10, 10 };
+        //   0 -  ,     ,
+        //   -        
+        std::array<size_t, GENERATIONS> counts_{};
+        bool enabled_ = true;
+        bool collecting_ = false;
+        GcStats stats_;
+    };
+
+}  // namespace runtime
@@ -0,0 +1,122 @@
+#include "gc.h"
+#include "lexer.h"
+#include "parse.h"
+#include "statement.h"
+#include "test_runner_p.h"
+
+using namespace std;
+
+namespace runtime {
+
+    namespace {
+        const string NODE_CLASSES = R"(
+class Node:
+  def __init__(name):
+    self.name = name
+    self.parent = None
+    self.child = None
+
+  def adopt(node):
+    node.parent = self
+    self.child = node
+
+  def loop():
+    self.me = self
+)"s;
+
+        unique_ptr<Executable> RunProgram(const string& program, Closure& closure) {
+            istringstream input(program);
+            parse::Lexer lexer(input);
+            auto tree = ParseProgram(lexer);
+            DummyContext context;
+            tree->Execute(closure, context);
+            return tree;
+        }
+
+        void TestCollectsCycles() {
+            CycleCollector& gc = CycleCollector::Current();
+            gc.Collect();
+            const size_t tracked = gc.GetTrackedCount();
+            const size_t collected = gc.GetStats().collected;
+
+            Closure closure;
+            auto tree = RunProgram(NODE_CLASSES + R"(
+p = Node(1)
+n = Node(2)
+p.adopt(n)
+single = Node(3)
+single.loop()
+)"s, closure);
+            ASSERT_EQUAL(gc.GetTrackedCount(), tracked + 3);
+            ASSERT_EQUAL(gc.Collect(), 0U);
+
+            closure.erase("p"s);
+            closure.erase("n"s);
+            closure.erase("single"s);
+            ASSERT_EQUAL(gc.GetTrackedCount(), tracked + 3);
+
+            ASSERT_EQUAL(gc.Collect(), 3U);
+            ASSERT_EQUAL(gc.GetTrackedCount(), tracked);
+            ASSERT_EQUAL(gc.GetStats().collected, collected + 3);
+        }
+
+        void TestKeepsReachableObjects() {
+            CycleCollector& gc = CycleCollector::Current();
+            gc.Collect();
+
+            Closure closure;
+            auto tree = RunProgram(NODE_CLASSES + R"(
+p = Node(1)
+n = Node(2)
+p.adopt(n)
+p = None
+)"s, closure);
+            // The cycle is still reachable through n
+            ASSERT_EQUAL(gc.Collect(), 0U);
+            const auto* node = closure.at("n"s).TryAs<ClassInstance>();
+            const auto* parent = node->FindField("parent"s)->TryAs<ClassInstance>();
+            ASSERT(parent != nullptr);
+            ASSERT_EQUAL(parent->FindField("name"s)->TryAs<Number>()->GetValue(), 1);
+
+            // Objects that are not owned through ObjectHolder are roots
+            Class cls{ "Local"s, {}, nullptr };
+            ClassInstance local{ cls };
+            local.SetField("n"s, closure.at("n"s));
+            closure.clear();
+            ASSERT_EQUAL(gc.Collect(), 0U);
+            local.ClearReferences();
+            ASSERT_EQUAL(gc.Collect(), 2U);
+        }
+
+        void TestGenerationThresholds() {
+            CycleCollector& gc = CycleCollector::Current();
+            gc.Collect();
+            const auto thresholds = gc.GetThresholds();
+            const GcStats before = gc.GetStats();
+
+            gc.SetThresholds({ 10, 2, 2 });
+            Closure closure;
+            string program = NODE_CLASSES;
+            for (int i = 0; i < 100; ++i) {
+                program += "x = Node("s + to_string(i) + ")\nx.loop()\n"s;
+            }
+            auto tree = RunProgram(program, closure);
+            gc.SetThresholds(thresholds);
+
+            const GcStats& after = gc.GetStats();
+            ASSERT(after.collections[0] > before.collections[0]);
+            ASSERT(after.collections[1] > before.collections[1]);
+            ASSERT(after.collected >= before.collected + 90);
+            ASSERT(after.max_pause >= after.last_pause);
+            ASSERT(after.total_pause >= after.max_pause);
+        }
+
+    }  // namespace
+
+    void RunCycleCollectorTests(TestRunner& tr) {
+        RUN_TEST(tr, runtime::TestCollectsCycles);
+        RUN_TEST(tr, runtime::TestKeepsReachableObjects);
+        RUN_TEST(tr, runtime::TestGenerationThresholds);
+    }
+
+}  // namespace runtime
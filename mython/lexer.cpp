@@ -20,6 +20,9 @@ namespace parse {
         if (lhs.Is<Number>()) {
             return lhs.As<Number>().value == rhs.As<Number>().value;
         }
+        if (lhs.Is<BigNumber>()) {
+            return lhs.As<BigNumber>().value == rhs.As<BigNumber>().value;
+        }
         if (lhs.Is<String>()) {
             return lhs.As<String>().value == rhs.As<String>().value;
         }
@@ -40,6 +43,7 @@ namespace parse {
     if (auto p = rhs.TryAs<type>()) return os << #type << '{' << p->value << '}';
 
         VALUED_OUTPUT(Number);
+        VALUED_OUTPUT(BigNumber);
         VALUED_OUTPUT(Id);
         VALUED_OUTPUT(String);
         VALUED_OUTPUT(Char);
@@ -53,6 +57,11 @@ namespace parse {
         UNVALUED_OUTPUT(Return);
         UNVALUED_OUTPUT(If);
         UNVALUED_OUTPUT(Else);
+        UNVALUED_OUTPUT(While);
+        UNVALUED_OUTPUT(For);
+        UNVALUED_OUTPUT(In);
+        UNVALUED_OUTPUT(Break);
+        UNVALUED_OUTPUT(Continue);
         UNVALUED_OUTPUT(Def);
         UNVALUED_OUTPUT(Newline);
         UNVALUED_OUTPUT(Print);
@@ -65,6 +74,10 @@ namespace parse {
         UNVALUED_OUTPUT(NotEq);
         UNVALUED_OUTPUT(LessOrEq);
         UNVALUED_OUTPUT(GreaterOrEq);
+        UNVALUED_OUTPUT(AddAssign);
+        UNVALUED_OUTPUT(SubAssign);
+        UNVALUED_OUTPUT(MultAssign);
+        UNVALUED_OUTPUT(DivAssign);
         UNVALUED_OUTPUT(None);
         UNVALUED_OUTPUT(True);
         UNVALUED_OUTPUT(False);
@@ -141,7 +154,15 @@ namespace parse {
                 curr_token_ = str_to_token.at(lexem);
             }
             else if (LexemIsNumber(lexem)) {
-                curr_token_ = token_type::Number(stoi(lexem));
+                int64_t value = 0;
+                auto [end, ec] = from_chars(lexem.data(), lexem.data() + lexem.size(), value);
+                if (ec == errc::result_out_of_range) {
+                    //     BigNumber    
+                    curr_token_ = token_type::BigNumber(lexem);
+                }
+                else {
+                    curr_token_ = token_type::Number(value);
+                }
             }
             else if (LexemIsId(lexem)) {
                 curr_token_ = token_type::Id(lexem);
@@ -166,21 +187,18 @@ namespace parse {
         using namespace std::literals;
         std::string result = ""s;
         char opening_quote = curr_line_[0];
-        curr_line_ = curr_line_.substr(1);
         bool escape_seq = false;
-        for (char c : curr_line_) {
-            if (c == '\\') {
+        size_t pos = 1;
+        for (; pos < curr_line_.size(); ++pos) {
+            char c = curr_line_[pos];
+            if (c == '\\' && !escape_seq) {
                 escape_seq = true;
                 continue;
             }
 
-            if (c == opening_quote) {
-                if (escape_seq) {
-                    result += opening_quote;
-                }
-                else {
-                    return result;
-                }
+            if (c == opening_quote && !escape_seq) {
+                ++pos;
+                break;
             }
             else if (c == 't' && escape_seq) {
                 result += '\t';
@@ -193,6 +211,9 @@ namespace parse {
             }
             escape_seq = false;
         }
+        //     ,   .
+        //    : escape-      
+        curr_line_.erase(0, pos);
         return result;
     }
 
@@ -238,6 +259,10 @@ namespace parse {
                 curr_line_.find(')'),
                 curr_line_.find(','),
                 curr_line_.find(':'),
+                curr_line_.find('['),
+                curr_line_.find(']'),
+                curr_line_.find('{'),
+                curr_line_.find('}'),
                 curr_line_.find('.'),
                 curr_line_.find('#'),
                 curr_line_.find('+'),
@@ -245,13 +270,19 @@ namespace parse {
                 curr_line_.find('*'),
                 curr_line_.find('/')
                 });
-        return curr_line_.substr(0, lexem_end == 0 ? 1 : lexem_end);
+        if (lexem_end == 0) {
+            //  ,    '=',    
+            bool augmented = "+-*/"s.find(curr_line_[0]) != string::npos &&
+                             curr_line_.size() > 1 && curr_line_[1] == '=';
+            size_t length = augmented ? 2 : 1;
+            return curr_line_.substr(0, length);
+        }
+        return curr_line_.substr(0, lexem_end);
     }
 
     void Lexer::ProcessString() {
         string str = ParseString();
         curr_token_ = token_type::String(str);
-        curr_line_.erase(0, str.size() + 1/*quote*/ + 1/*space*/);
     }
 
     void Lexer::ProcessSingleIndentDedent() {
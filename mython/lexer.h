@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
 #include <optional>
 #include <sstream>
@@ -21,11 +22,20 @@ namespace parse {
     namespace token_type {
         struct Number {  //  
             Number() = default;
-            Number(int value)
+            Number(int64_t value)
                 : value(value)
             {}
 
-            int value;   // 
+            int64_t value;   // 
+        };
+
+        struct BigNumber {  //  ,    int64_t
+            BigNumber() = default;
+            BigNumber(const std::string& value)
+                : value(value)
+            {}
+
+            std::string value;  //   
         };
 
         struct Id {             //  
@@ -57,6 +67,11 @@ namespace parse {
         struct Return {};   //  return
         struct If {};       //  if
         struct Else {};     //  else
+        struct While {};    //  while
+        struct For {};      //  for
+        struct In {};       //  in
+        struct Break {};    //  break
+        struct Continue {}; //  continue
         struct Def {};      //  def
         struct Newline {};  //   
         struct Print {};    //  print
@@ -70,17 +85,23 @@ namespace parse {
         struct NotEq {};   //  !=
         struct LessOrEq {};     //  <=
         struct GreaterOrEq {};  //  >=
+        struct AddAssign {};    //  +=
+        struct SubAssign {};    //  -=
+        struct MultAssign {};   //  *=
+        struct DivAssign {};    //  /=
         struct None {};         //  None
         struct True {};         //  True
         struct False {};        //  False
     }  // namespace token_type
 
     using TokenBase
-        = std::variant<token_type::Number, token_type::Id, token_type::Char, token_type::String,
+        = std::variant<token_type::Number, token_type::BigNumber, token_type::Id, token_type::Char, token_type::String,
         token_type::Class, token_type::Return, token_type::If, token_type::Else,
+        token_type::While, token_type::For, token_type::In, token_type::Break, token_type::Continue,
         token_type::Def, token_type::Newline, token_type::Print, token_type::Indent,
         token_type::Dedent, token_type::And, token_type::Or, token_type::Not,
         token_type::Eq, token_type::NotEq, token_type::LessOrEq, token_type::GreaterOrEq,
+        token_type::AddAssign, token_type::SubAssign, token_type::MultAssign, token_type::DivAssign,
         token_type::None, token_type::True, token_type::False, token_type::Eof>;
 
     struct Token : TokenBase {
@@ -118,6 +139,11 @@ namespace parse {
         {"return"s, token_type::Return()},
         {"if"s, token_type::If()},
         {"else"s, token_type::Else()},
+        {"while"s, token_type::While()},
+        {"for"s, token_type::For()},
+        {"in"s, token_type::In()},
+        {"break"s, token_type::Break()},
+        {"continue"s, token_type::Continue()},
         {"def"s, token_type::Def()},
         {"print"s, token_type::Print()},
         {"and"s, token_type::And()},
@@ -127,6 +153,10 @@ namespace parse {
         {">="s, token_type::GreaterOrEq()},
         {"=="s, token_type::Eq()},
         {"!="s, token_type::NotEq()},
+        {"+="s, token_type::AddAssign()},
+        {"-="s, token_type::SubAssign()},
+        {"*="s, token_type::MultAssign()},
+        {"/="s, token_type::DivAssign()},
         {"None", token_type::None()},
         {"True"s, token_type::True()},
         {"False"s, token_type::False()}
@@ -40,6 +40,19 @@ namespace parse {
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::False{}));
         }
 
+        void TestLoopKeywords() {
+            istringstream input("while break continue whiles for in inner"s);
+            Lexer lexer(input);
+
+            ASSERT_EQUAL(lexer.CurrentToken(), Token(token_type::While{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Break{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Continue{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "whiles"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::For{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::In{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "inner"s }));
+        }
+
         void TestNumbers() {
             istringstream input("42 15 -53"s);
             Lexer lexer(input);
@@ -51,6 +64,17 @@ namespace parse {
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Number{ 53 }));
         }
 
+        void TestLongNumbers() {
+            istringstream input("9223372036854775807 9223372036854775808 99999999999999999999"s);
+            Lexer lexer(input);
+
+            ASSERT_EQUAL(lexer.CurrentToken(), Token(token_type::Number{ INT64_MAX }));
+            // ,    int64_t,    
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::BigNumber{ "9223372036854775808"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::BigNumber{ "99999999999999999999"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Newline{}));
+        }
+
         void TestIds() {
             istringstream input("x    _42 big_number   Return Class  dEf"s);
             Lexer lexer(input);
@@ -77,6 +101,22 @@ namespace parse {
                 Token(token_type::String{ "another long string with single quote ' inside"s }));
         }
 
+        void TestStringsFollowedByDelimiters() {
+            istringstream input(R"(['a', 'it\'s'] str('x'))"s);
+            Lexer lexer(input);
+
+            ASSERT_EQUAL(lexer.CurrentToken(), Token(token_type::Char{ '[' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::String{ "a"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ ',' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::String{ "it's"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ ']' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "str"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '(' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::String{ "x"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ ')' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Newline{}));
+        }
+
         void TestOperations() {
             istringstream input("+-*/= > < != == <> <= >="s);
             Lexer lexer(input);
@@ -84,8 +124,8 @@ namespace parse {
             ASSERT_EQUAL(lexer.CurrentToken(), Token(token_type::Char{ '+' }));
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '-' }));
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '*' }));
-            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '/' }));
-            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '=' }));
+            // "/=" -   ,     
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::DivAssign{}));
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '>' }));
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '<' }));
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::NotEq{}));
@@ -96,6 +136,31 @@ namespace parse {
             ASSERT_EQUAL(lexer.NextToken(), Token(token_type::GreaterOrEq{}));
         }
 
+        void TestAugmentedAssignmentOperators() {
+            istringstream input("x+=1 y -= -2\nz.w *=3/ 4\nv/=x"s);
+            Lexer lexer(input);
+
+            ASSERT_EQUAL(lexer.CurrentToken(), Token(token_type::Id{ "x"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::AddAssign{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Number{ 1 }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "y"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::SubAssign{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '-' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Number{ 2 }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Newline{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "z"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '.' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "w"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::MultAssign{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Number{ 3 }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Char{ '/' }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Number{ 4 }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Newline{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "v"s }));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::DivAssign{}));
+            ASSERT_EQUAL(lexer.NextToken(), Token(token_type::Id{ "x"s }));
+        }
+
         void TestIndentsAndNewlines() {
             istringstream input(R"(
 no_indent
@@ -356,10 +421,14 @@ abc#
     void RunOpenLexerTests(TestRunner& tr) {
         RUN_TEST(tr, parse::TestSimpleAssignment);
         RUN_TEST(tr, parse::TestKeywords);
+        RUN_TEST(tr, parse::TestLoopKeywords);
         RUN_TEST(tr, parse::TestNumbers);
+        RUN_TEST(tr, parse::TestLongNumbers);
         RUN_TEST(tr, parse::TestIds);
         RUN_TEST(tr, parse::TestStrings);
+        RUN_TEST(tr, parse::TestStringsFollowedByDelimiters);
         RUN_TEST(tr, parse::TestOperations);
+        RUN_TEST(tr, parse::TestAugmentedAssignmentOperators);
         RUN_TEST(tr, parse::TestIndentsAndNewlines);
         RUN_TEST(tr, parse::TestEmptyLinesAreIgnored);
         RUN_TEST(tr, parse::TestExpect);
@@ -1,11 +1,15 @@
 #include "lexer.h"
 #include "parse.h"
+#include "program.h"
 #include "runtime.h"
 #include "statement.h"
 #include "test_runner_p.h"
 
 #include <iostream>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace std;
 
 namespace parse {
@@ -18,19 +22,39 @@ namespace ast {
 namespace runtime {
     void RunObjectHolderTests(TestRunner& tr);
     void RunObjectsTests(TestRunner& tr);
+    void RunCycleCollectorTests(TestRunner& tr);
 }  // namespace runtime
 
 void TestParseProgram(TestRunner& tr);
 
 namespace {
 
-    void RunMythonProgram(istream& input, ostream& output) {
-        parse::Lexer lexer(input);
-        auto program = ParseProgram(lexer);
+    //       ,    
+    // CallStack,     
+    constexpr size_t PROGRAM_STACK_SIZE = size_t{ 512 } * 1024 * 1024;
+    constexpr size_t PROGRAM_MAX_DEPTH = 500'000;
+
+    void RunMythonProgram(istream& input, runtime::SimpleContext& context, size_t max_depth) {
+        const Program program = Program::Compile(input);
+
+        context.GetCallStack().SetMaxDepth(max_depth);
+        runtime::Closure globals;
+        program.Run(context, globals);
+    }
 
+    void RunMythonProgram(istream& input, ostream& output, size_t max_depth = runtime::CallStack::DEFAULT_MAX_DEPTH) {
         runtime::SimpleContext context{ output };
-        runtime::Closure closure;
-        program->Execute(closure, context);
+        RunMythonProgram(input, context, max_depth);
+    }
+
+    //     stdout ,  .  stdout -   ,
+    //    ,      
+    unique_ptr<runtime::OutputSink> MakeStdoutSink() {
+        struct stat info {};
+        if (fstat(STDOUT_FILENO, &info) == 0 && (S_ISFIFO(info.st_mode) || S_ISSOCK(info.st_mode))) {
+            return make_unique<runtime::AsyncFdOutputSink>(STDOUT_FILENO);
+        }
+        return make_unique<runtime::FdOutputSink>(STDOUT_FILENO);
     }
 
     void TestSimplePrints() {
@@ -117,6 +141,7 @@ print y.value
         parse::RunOpenLexerTests(tr);
         runtime::RunObjectHolderTests(tr);
         runtime::RunObjectsTests(tr);
+        runtime::RunCycleCollectorTests(tr);
         ast::RunUnitTests(tr);
         TestParseProgram(tr);
 
@@ -131,7 +156,10 @@ print y.value
 int main() {
     try {
         TestAll();
-        RunMythonProgram(cin, cout);
+        runtime::RunWithStackSize(PROGRAM_STACK_SIZE, [] {
+            runtime::SimpleContext context{ MakeStdoutSink() };
+            RunMythonProgram(cin, context, PROGRAM_MAX_DEPTH);
+        });
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,52 @@
+#include "native.h"
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace std;
+
+namespace runtime {
+
+    NativeArgs::NativeArgs(const Closure& frame)
+        : begin_(frame.begin() + 1)
+        , size_(frame.size() - 1)
+    {
+    }
+
+    size_t NativeArgs::size() const {
+        return size_;
+    }
+
+    const ObjectHolder& NativeArgs::operator[](size_t index) const {
+        assert(index < size_);
+        return begin_[static_cast<ptrdiff_t>(index)].second;
+    }
+
+    int64_t NativeArgs::GetNumber(size_t index) const {
+        const ObjectHolder& arg = (*this)[index];
+        if (arg.GetTypeTag() != TypeTag::NUMBER) {
+            throw runtime_error("Argument "s + to_string(index + 1) + " must be a number"s);
+        }
+        return static_cast<const Number&>(*arg).GetValue();
+    }
+
+    const std::string& NativeArgs::GetString(size_t index) const {
+        const ObjectHolder& arg = (*this)[index];
+        if (arg.GetTypeTag() != TypeTag::STRING) {
+            throw runtime_error("Argument "s + to_string(index + 1) + " must be a string"s);
+        }
+        return static_cast<const String&>(*arg).GetValue();
+    }
+
+    NativeMethodBody::NativeMethodBody(Function function)
+        : function_(move(function))
+    {
+    }
+
+    ObjectHolder NativeMethodBody::Execute(Closure& closure, Context& context) {
+        //       self
+        auto& self = static_cast<ClassInstance&>(*closure.begin()->second);
+        return function_(self, NativeArgs(closure), context);
+    }
+
+}  // namespace runtime
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "runtime.h"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+    /*
+     *   .    :    self
+     *       ,     ,
+     *       
+     */
+    class NativeArgs {
+    public:
+        explicit NativeArgs(const Closure& frame);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] const ObjectHolder& operator[](size_t index) const;
+
+        //     index   runtime_error
+        [[nodiscard]] int64_t GetNumber(size_t index) const;
+        //     index   runtime_error
+        [[nodiscard]] const std::string& GetString(size_t index) const;
+
+    private:
+        Closure::const_iterator begin_;
+        size_t size_;
+    };
+
+    //  ,   C++
+    class NativeMethodBody : public Executable {
+    public:
+        using Function = std::function<ObjectHolder(ClassInstance& self, const NativeArgs& args, Context& context)>;
+
+        explicit NativeMethodBody(Function function);
+
+        //    self     closure
+        ObjectHolder Execute(Closure& closure, Context& context) override;
+
+    private:
+        Function function_;
+    };
+
+    // C++-  T,     
+    template <typename T>
+    struct NativeValue : NativeData {
+        T value{};
+    };
+
+    //  C++-  T  instance  nullptr,      T
+    template <typename T>
+    [[nodiscard]] T* TryGetNative(const ClassInstance& instance) {
+        auto* data = dynamic_cast<NativeValue<T>*>(instance.GetNativeData());
+        return data ? &data->value : nullptr;
+    }
+
+    //  C++-  T,    index,   runtime_error
+    template <typename T>
+    [[nodiscard]] T& GetNativeArgument(const NativeArgs& args, size_t index) {
+        const auto* instance = args[index].TryAs<ClassInstance>();
+        T* value = instance ? TryGetNative<T>(*instance) : nullptr;
+        if (!value) {
+            throw std::runtime_error("Argument " + std::to_string(index + 1) + " has a wrong type");
+        }
+        return *value;
+    }
+
+    //     cls,  C++- value
+    template <typename T>
+    [[nodiscard]] ObjectHolder MakeNativeInstance(const Class& cls, T value) {
+        ObjectHolder result = ObjectHolder::Own(ClassInstance(cls));
+        T* native = TryGetNative<T>(static_cast<const ClassInstance&>(*result));
+        if (!native) {
+            throw std::runtime_error("Class " + cls.GetName() + " doesn't wrap this native type");
+        }
+        *native = std::move(value);
+        return result;
+    }
+
+    /*
+     *   Mython,    C++-  T.
+     *        ,   __init__
+     * (  )  .       
+     *  ObjectHolder.   -   ,   
+     *  ,   ,     Mython  
+     *   __str__, __eq__, __lt__   dunder-.
+     *
+     * C++-    ,      ObjectHolder,
+     *    .
+     *
+     * :
+     *   auto point = NativeClassBuilder<Point>("Point")
+     *       .Method("__init__", 2, [](Point& p, const NativeArgs& args, Context&) {
+     *           p = { args.GetNumber(0), args.GetNumber(1) };
+     *           return ObjectHolder::None();
+     *       })
+     *       .Build();
+     */
+    template <typename T>
+    class NativeClassBuilder {
+    public:
+        using Function = std::function<ObjectHolder(T& self, const NativeArgs& args, Context& context)>;
+
+        explicit NativeClassBuilder(std::string name, const Class* parent = nullptr)
+            : name_(std::move(name))
+            , parent_(parent) {
+        }
+
+        //   name  arg_count 
+        NativeClassBuilder& Method(const std::string& name, size_t arg_count, Function function) {
+            runtime::Method method;
+            method.name = name;
+            for (size_t i = 0; i < arg_count; ++i) {
+                method.formal_params.push_back("arg" + std::to_string(i));
+            }
+            method.body = std::make_unique<NativeMethodBody>(
+                [name, function = std::move(function)](ClassInstance& self, const NativeArgs& args,
+                                                       Context& context) {
+                    T* value = TryGetNative<T>(self);
+                    if (!value) {
+                        throw std::runtime_error("Native method " + name + " called on a foreign object");
+                    }
+                    return function(*value, args, context);
+                });
+            methods_.push_back(std::move(method));
+            return *this;
+        }
+
+        //  ObjectHolder,   
+        [[nodiscard]] ObjectHolder Build() {
+            return ObjectHolder::Own(Class(name_, std::move(methods_), parent_, MakeValue));
+        }
+
+    private:
+        static std::unique_ptr<NativeData> MakeValue() {
+            return std::make_unique<NativeValue<T>>();
+        }
+
+        std::string name_;
+        const Class* parent_;
+        std::vector<runtime::Method> methods_;
+    };
+
+}  // namespace runtime
@@ -0,0 +1,242 @@
+#include "output.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace runtime {
+
+    namespace {
+
+        //  head,    tail,   fd.    .
+        // write     :  ,    
+        size_t WriteAll(int fd, string_view head, string_view tail) {
+            iovec parts[2] = {
+                { const_cast<char*>(head.data()), head.size() },
+                { const_cast<char*>(tail.data()), tail.size() },
+            };
+            iovec* current = parts;
+            int count = 2;
+            size_t calls = 0;
+            while (count > 0) {
+                if (current->iov_len == 0) {
+                    ++current;
+                    --count;
+                    continue;
+                }
+                ++calls;
+                ssize_t written = count == 1 ? write(fd, current->iov_base, current->iov_len)
+                                             : writev(fd, current, count);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw runtime_error("Output error: "s + strerror(errno));
+                }
+                size_t rest = static_cast<size_t>(written);
+                while (count > 0 && rest >= current->iov_len) {
+                    rest -= current->iov_len;
+                    ++current;
+                    --count;
+                }
+                if (count > 0) {
+                    current->iov_base = static_cast<char*>(current->iov_base) + rest;
+                    current->iov_len -= rest;
+                }
+            }
+            return calls;
+        }
+
+    }  // namespace
+
+    void AppendInteger(string& out, int64_t value) {
+        //   int64_t    - 20    
+        char digits[20];
+        auto [end, ec] = to_chars(begin(digits), std::end(digits), value);
+        out.append(digits, end);
+    }
+
+    StringAppendBuf::int_type StringAppendBuf::overflow(int_type c) {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            data_.push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    streamsize StringAppendBuf::xsputn(const char* s, streamsize n) {
+        data_.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+    OutputSink::OutputSink(size_t flush_threshold)
+        : flush_threshold_(flush_threshold)
+    {
+        buffer_.reserve(flush_threshold_);
+    }
+
+    void OutputSink::Flush() {
+        if (buffer_.empty()) {
+            return;
+        }
+        Drain(buffer_, {});
+        buffer_.clear();
+    }
+
+    void OutputSink::WriteLarge(string_view data) {
+        Drain(buffer_, data);
+        buffer_.clear();
+    }
+
+    StreamOutputSink::StreamOutputSink(ostream& output, size_t flush_threshold)
+        : OutputSink(flush_threshold)
+        , output_(output)
+    {}
+
+    StreamOutputSink::~StreamOutputSink() {
+        try {
+            Flush();
+        }
+        catch (...) {
+        }
+    }
+
+    void StreamOutputSink::Drain(string_view head, string_view tail) {
+        output_.write(head.data(), static_cast<streamsize>(head.size()));
+        output_.write(tail.data(), static_cast<streamsize>(tail.size()));
+    }
+
+    FdOutputSink::FdOutputSink(int fd, size_t flush_threshold)
+        : OutputSink(flush_threshold)
+        , fd_(fd)
+    {}
+
+    FdOutputSink::~FdOutputSink() {
+        try {
+            Flush();
+        }
+        catch (...) {
+        }
+    }
+
+    void FdOutputSink::Drain(string_view head, string_view tail) {
+        write_calls_ += WriteAll(fd_, head, tail);
+    }
+
+    AsyncFdOutputSink::AsyncFdOutputSink(int fd, Backpressure policy, size_t ring_size, size_t flush_threshold)
+        : OutputSink(flush_threshold)
+        , fd_(fd)
+        , policy_(policy)
+        , blocks_(ring_size)
+    {
+        if (ring_size == 0) {
+            throw runtime_error("Output ring must not be empty"s);
+        }
+        writer_ = thread([this] {
+            WriterLoop();
+        });
+    }
+
+    AsyncFdOutputSink::~AsyncFdOutputSink() {
+        //          DROP
+        closing_ = true;
+        try {
+            Flush();
+        }
+        catch (...) {
+        }
+        {
+            lock_guard lock(mutex_);
+            stopping_.store(true);
+        }
+        has_blocks_.notify_one();
+        writer_.join();
+    }
+
+    void AsyncFdOutputSink::WaitWritten() {
+        Flush();
+        const size_t pushed = pushed_.load(memory_order_relaxed);
+        if (popped_.load() != pushed) {
+            unique_lock lock(mutex_);
+            producer_sleeping_.store(true);
+            has_space_.wait(lock, [&] {
+                return popped_.load() == pushed;
+            });
+            producer_sleeping_.store(false);
+        }
+        ThrowIfFailed();
+    }
+
+    void AsyncFdOutputSink::ThrowIfFailed() {
+        if (failed_.load(memory_order_acquire)) {
+            throw runtime_error(error_);
+        }
+    }
+
+    void AsyncFdOutputSink::Drain(string_view head, string_view tail) {
+        ThrowIfFailed();
+        const size_t pushed = pushed_.load(memory_order_relaxed);
+        if (pushed - popped_.load(memory_order_acquire) == blocks_.size()) {
+            if (policy_ == Backpressure::DROP && !closing_) {
+                dropped_bytes_.fetch_add(head.size() + tail.size(), memory_order_relaxed);
+                return;
+            }
+            ++stalls_;
+            //     popped_     :
+            //        ,     
+            unique_lock lock(mutex_);
+            producer_sleeping_.store(true);
+            has_space_.wait(lock, [&] {
+                return pushed - popped_.load() < blocks_.size();
+            });
+            producer_sleeping_.store(false);
+        }
+        string& block = blocks_[pushed % blocks_.size()];
+        block.assign(head);
+        block.append(tail);
+        pushed_.store(pushed + 1);
+        if (writer_sleeping_.load()) {
+            lock_guard lock(mutex_);
+            has_blocks_.notify_one();
+        }
+    }
+
+    void AsyncFdOutputSink::WriterLoop() {
+        size_t popped = popped_.load(memory_order_relaxed);
+        while (true) {
+            if (pushed_.load(memory_order_acquire) == popped) {
+                unique_lock lock(mutex_);
+                writer_sleeping_.store(true);
+                has_blocks_.wait(lock, [&] {
+                    return pushed_.load() != popped || stopping_.load();
+                });
+                writer_sleeping_.store(false);
+                if (pushed_.load() == popped) {
+                    // :       stopping_
+                    return;
+                }
+            }
+            string& block = blocks_[popped % blocks_.size()];
+            if (!failed_.load(memory_order_relaxed)) {
+                try {
+                    WriteAll(fd_, block, {});
+                }
+                catch (const exception& e) {
+                    error_ = e.what();
+                    failed_.store(true, memory_order_release);
+                }
+            }
+            popped_.store(++popped);
+            if (producer_sleeping_.load()) {
+                lock_guard lock(mutex_);
+                has_space_.notify_one();
+            }
+        }
+    }
+
+}  // namespace runtime
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+    //    value   out  iostream
+    void AppendInteger(std::string& out, int64_t value);
+
+    //  ,      .  ,
+    //    std::ostream,    -   
+    class StringAppendBuf : public std::streambuf {
+    public:
+        explicit StringAppendBuf(std::string& data)
+            : data_(data) {
+        }
+
+    protected:
+        int_type overflow(int_type c) override;
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+    private:
+        std::string& data_;
+    };
+
+    /*
+     *    print.
+     *         (Drain) 
+     * :   Commit,      flush_threshold,  
+     *        Flush. Print  Commit   ,
+     *       ,    .
+     * ,      std::ostream,     GetStream()
+     */
+    class OutputSink {
+    public:
+        explicit OutputSink(size_t flush_threshold);
+
+        OutputSink(const OutputSink&) = delete;
+        OutputSink& operator=(const OutputSink&) = delete;
+
+        //    Flush   :  Drain  
+        virtual ~OutputSink() = default;
+
+        void Write(std::string_view data) {
+            if (data.size() >= flush_threshold_ && flush_threshold_ > 0) {
+                WriteLarge(data);
+                return;
+            }
+            buffer_.append(data);
+        }
+
+        void Write(char c) {
+            buffer_.push_back(c);
+        }
+
+        //    value  iostream
+        void WriteInteger(int64_t value) {
+            AppendInteger(buffer_, value);
+        }
+
+        //    ( print).   ,   
+        void Commit() {
+            if (buffer_.size() >= flush_threshold_) {
+                Flush();
+            }
+        }
+
+        //    
+        void Flush();
+
+        // ,        ,   Write
+        std::ostream& GetStream() {
+            return stream_;
+        }
+
+        // ,        (, Object::AppendTo).
+        //     ,    Write
+        std::string& GetBuffer() {
+            return buffer_;
+        }
+
+        [[nodiscard]] size_t GetFlushThreshold() const {
+            return flush_threshold_;
+        }
+
+        //  ,  
+        [[nodiscard]] size_t GetBufferedSize() const {
+            return buffer_.size();
+        }
+
+    protected:
+        //   head,    tail.      
+        virtual void Drain(std::string_view head, std::string_view tail) = 0;
+
+    private:
+        void WriteLarge(std::string_view data);
+
+        size_t flush_threshold_;
+        std::string buffer_;
+        StringAppendBuf streambuf_{ buffer_ };
+        std::ostream stream_{ &streambuf_ };
+    };
+
+    /*
+     * ,    std::ostream.    SimpleContext:
+     *      print       ,
+     *   write    <<
+     */
+    class StreamOutputSink : public OutputSink {
+    public:
+        explicit StreamOutputSink(std::ostream& output, size_t flush_threshold = 0);
+        ~StreamOutputSink() override;
+
+    protected:
+        void Drain(std::string_view head, std::string_view tail) override;
+
+    private:
+        std::ostream& output_;
+    };
+
+    /*
+     * ,        write/writev.
+     *   ,    ,    writev.
+     *   .      runtime_error
+     */
+    class FdOutputSink : public OutputSink {
+    public:
+        static constexpr size_t DEFAULT_FLUSH_THRESHOLD = size_t{ 64 } * 1024;
+
+        explicit FdOutputSink(int fd, size_t flush_threshold = DEFAULT_FLUSH_THRESHOLD);
+        //   .     
+        ~FdOutputSink() override;
+
+        //     
+        [[nodiscard]] size_t GetWriteCalls() const {
+            return write_calls_;
+        }
+
+    protected:
+        void Drain(std::string_view head, std::string_view tail) override;
+
+    private:
+        int fd_;
+        size_t write_calls_ = 0;
+    };
+
+    //       
+    enum class Backpressure {
+        // ,     
+        BLOCK,
+        //        GetDroppedBytes
+        DROP
+    };
+
+    /*
+     * ,          .
+     *      write,   (, 
+     *   )    :     
+     *         ,  
+     * .     .    
+     *  policy.         .
+     *
+     *  Write, Commit  Flush    .   
+     * ,       ,     .
+     *        runtime_error  
+     * Flush/Commit;   
+     */
+    class AsyncFdOutputSink : public OutputSink {
+    public:
+        static constexpr size_t DEFAULT_RING_SIZE = 32;
+
+        explicit AsyncFdOutputSink(int fd, Backpressure policy = Backpressure::BLOCK,
+            size_t ring_size = DEFAULT_RING_SIZE,
+            size_t flush_threshold = FdOutputSink::DEFAULT_FLUSH_THRESHOLD);
+        ~AsyncFdOutputSink() override;
+
+        // ,        
+        void WaitWritten();
+
+        //  ,   Backpressure::DROP
+        [[nodiscard]] size_t GetDroppedBytes() const {
+            return dropped_bytes_.load(std::memory_order_relaxed);
+        }
+
+        //  ,       
+        [[nodiscard]] size_t GetStalls() const {
+            return stalls_;
+        }
+
+    protected:
+        void Drain(std::string_view head, std::string_view tail) override;
+
+    private:
+        void WriterLoop();
+        void ThrowIfFailed();
+
+        int fd_;
+        Backpressure policy_;
+        std::vector<std::string> blocks_;
+        //        ;   -    
+        std::atomic<size_t> pushed_{ 0 };
+        std::atomic<size_t> popped_{ 0 };
+        std::atomic<size_t> dropped_bytes_{ 0 };
+        size_t stalls_ = 0;
+        bool closing_ = false;
+
+        //         ,     
+        std::mutex mutex_;
+        std::condition_variable has_blocks_;
+        std::condition_variable has_space_;
+        std::atomic<bool> writer_sleeping_{ false };
+        std::atomic<bool> producer_sleeping_{ false };
+        std::atomic<bool> stopping_{ false };
+
+        std::atomic<bool> failed_{ false };
+        std::string error_;
+
+        std::thread writer_;
+    };
+
+}  // namespace runtime
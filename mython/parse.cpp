@@ -19,8 +19,9 @@ namespace {
 
     class Parser {
     public:
-        explicit Parser(parse::Lexer& lexer)
-            : lexer_(lexer) {
+        Parser(parse::Lexer& lexer, const runtime::BuiltinRegistry& builtins)
+            : lexer_(lexer)
+            , builtins_(builtins) {
         }
 
         // Program -> eps
@@ -76,7 +77,12 @@ namespace {
                 lexer_.ExpectNext<TokenType::Char>(':');
                 lexer_.NextToken();
 
+                // break  continue       ,    
+                const size_t outer_loop_depth = std::exchange(loop_depth_, 0);
+                ++method_depth_;
                 m.body = std::make_unique<ast::MethodBody>(ParseSuite());  // NOLINT
+                --method_depth_;
+                loop_depth_ = outer_loop_depth;
 
                 result.push_back(std::move(m));
             }
@@ -96,11 +102,10 @@ namespace {
                 lexer_.ExpectNext<TokenType::Char>(')');
                 lexer_.NextToken();
 
-                auto it = declared_classes_.find(name);
-                if (it == declared_classes_.end()) {
+                base_class = FindClass(name);
+                if (!base_class) {
                     throw ParseError("Base class "s + name + " not found for class "s + class_name);
                 }
-                base_class = static_cast<const runtime::Class*>(it->second.Get());  // NOLINT
             }
 
             lexer_.Expect<TokenType::Char>(':');
@@ -112,10 +117,9 @@ namespace {
             lexer_.Expect<TokenType::Dedent>();
             lexer_.NextToken();
 
-            auto [it, inserted] = declared_classes_.insert({
+            auto [it, inserted] = declared_classes_.emplace(
                 class_name,
-                runtime::ObjectHolder::Own(runtime::Class(class_name, std::move(methods), base_class)),
-                });
+                runtime::ObjectHolder::Own(runtime::Class(class_name, std::move(methods), base_class)));
 
             if (!inserted) {
                 throw ParseError("Class "s + class_name + " already exists"s);
@@ -124,6 +128,14 @@ namespace {
             return make_unique<ast::ClassDefinition>(it->second);
         }
 
+        //  ,        ,  nullptr
+        const runtime::Class* FindClass(const string& name) const {
+            if (auto it = declared_classes_.find(name); it != declared_classes_.end()) {
+                return static_cast<const runtime::Class*>(it->second.Get());  // NOLINT
+            }
+            return builtins_.FindClass(name);
+        }
+
         vector<string> ParseDottedIds() {
             vector<string> result(1, lexer_.Expect<TokenType::Id>().value);
 
@@ -135,11 +147,15 @@ namespace {
         }
 
         //  AssgnOrCall -> DottedIds = Expr
+        //               | DottedIds ['[' Expr ']']+ = Expr
         //               | DottedIds '(' ExprList ')'
         unique_ptr<ast::Statement> ParseAssignmentOrCall() {
             lexer_.Expect<TokenType::Id>();
 
             vector<string> id_list = ParseDottedIds();
+            if (lexer_.CurrentToken() == '[') {
+                return ParseIndexAssignment(make_unique<ast::VariableValue>(std::move(id_list)));
+            }
             string last_name = id_list.back();
             id_list.pop_back();
 
@@ -152,6 +168,13 @@ namespace {
                 return make_unique<ast::FieldAssignment>(ast::VariableValue{ std::move(id_list) },
                     std::move(last_name), ParseTest());
             }
+            if (auto op = TryParseAugmentedOperation()) {
+                if (id_list.empty()) {
+                    return make_unique<ast::AugmentedAssignment>(std::move(last_name), *op, ParseTest());
+                }
+                return make_unique<ast::AugmentedAssignment>(ast::VariableValue{ std::move(id_list) },
+                    std::move(last_name), *op, ParseTest());
+            }
             lexer_.Expect<TokenType::Char>('(');
             lexer_.NextToken();
 
@@ -170,6 +193,51 @@ namespace {
                 std::move(last_name), std::move(args));
         }
 
+        //    -    (+=, -=, *=, /=),     
+        std::optional<ast::AugmentedAssignment::Operation> TryParseAugmentedOperation() {
+            using Operation = ast::AugmentedAssignment::Operation;
+            const auto& token = lexer_.CurrentToken();
+            std::optional<Operation> op;
+            if (token.Is<TokenType::AddAssign>()) {
+                op = Operation::ADD;
+            }
+            else if (token.Is<TokenType::SubAssign>()) {
+                op = Operation::SUB;
+            }
+            else if (token.Is<TokenType::MultAssign>()) {
+                op = Operation::MULT;
+            }
+            else if (token.Is<TokenType::DivAssign>()) {
+                op = Operation::DIV;
+            }
+            if (op) {
+                lexer_.NextToken();
+            }
+            return op;
+        }
+
+        //  '[' Expr ']'    
+        unique_ptr<ast::Statement> ParseSubscript() {
+            lexer_.Expect<TokenType::Char>('[');
+            lexer_.NextToken();
+            auto index = ParseTest();
+            lexer_.Expect<TokenType::Char>(']');
+            lexer_.NextToken();
+            return index;
+        }
+
+        // IndexAssignment -> ['[' Expr ']']+ = Expr,  container -      '['
+        unique_ptr<ast::Statement> ParseIndexAssignment(unique_ptr<ast::Statement> container) {
+            auto index = ParseSubscript();
+            while (lexer_.CurrentToken() == '[') {
+                container = make_unique<ast::Index>(std::move(container), std::move(index));
+                index = ParseSubscript();
+            }
+            lexer_.Expect<TokenType::Char>('=');
+            lexer_.NextToken();
+            return make_unique<ast::IndexAssignment>(std::move(container), std::move(index), ParseTest());
+        }
+
         // Expr -> Adder ['+'/'-' Adder]*
         unique_ptr<ast::Statement> ParseExpression()  // NOLINT
         {
@@ -206,16 +274,59 @@ namespace {
             return result;
         }
 
-        // Mult -> '(' Expr ')'
-        //       | NUMBER
-        //       | '-' Mult
-        //       | STRING
-        //       | NONE
-        //       | TRUE
-        //       | FALSE
-        //       | DottedIds '(' ExprList ')'
-        //       | DottedIds
+        // Mult -> Primary [Postfix]*
+        // Postfix -> '[' Expr ']'
+        //          | '[' [Expr] ':' [Expr] ']'
+        //          | '.' Id '(' ExprList ')'
         unique_ptr<ast::Statement> ParseMult()  // NOLINT
+        {
+            CheckNesting();
+            unique_ptr<ast::Statement> result = ParsePrimary();
+            while (lexer_.CurrentToken() == '[' || lexer_.CurrentToken() == '.') {
+                if (lexer_.CurrentToken() == '.') {
+                    string method = lexer_.ExpectNext<TokenType::Id>().value;
+                    lexer_.ExpectNext<TokenType::Char>('(');
+                    vector<unique_ptr<ast::Statement>> args;
+                    if (lexer_.NextToken() != ')') {
+                        args = ParseTestList();
+                    }
+                    lexer_.Expect<TokenType::Char>(')');
+                    lexer_.NextToken();
+                    result = make_unique<ast::MethodCall>(std::move(result), std::move(method), std::move(args));
+                    continue;
+                }
+                unique_ptr<ast::Statement> start;
+                if (lexer_.NextToken() != ':') {
+                    start = ParseTest();
+                }
+                if (lexer_.CurrentToken() == ':') {
+                    unique_ptr<ast::Statement> stop;
+                    if (lexer_.NextToken() != ']') {
+                        stop = ParseTest();
+                    }
+                    result = make_unique<ast::Slice>(std::move(result), std::move(start), std::move(stop));
+                }
+                else {
+                    result = make_unique<ast::Index>(std::move(result), std::move(start));
+                }
+                lexer_.Expect<TokenType::Char>(']');
+                lexer_.NextToken();
+            }
+            return result;
+        }
+
+        // Primary -> '(' Expr ')'
+        //          | '[' [ExprList] ']'
+        //          | '{' [Expr ':' Expr [',' Expr ':' Expr]*] '}'
+        //          | NUMBER
+        //          | '-' Mult
+        //          | STRING
+        //          | NONE
+        //          | TRUE
+        //          | FALSE
+        //          | DottedIds '(' ExprList ')'
+        //          | DottedIds
+        unique_ptr<ast::Statement> ParsePrimary()  // NOLINT
         {
             if (lexer_.CurrentToken() == '(') {
                 lexer_.NextToken();
@@ -224,19 +335,49 @@ namespace {
                 lexer_.NextToken();
                 return result;
             }
+            if (lexer_.CurrentToken() == '[') {
+                vector<unique_ptr<ast::Statement>> items;
+                if (lexer_.NextToken() != ']') {
+                    items = ParseTestList();
+                }
+                lexer_.Expect<TokenType::Char>(']');
+                lexer_.NextToken();
+                return make_unique<ast::ListLiteral>(std::move(items));
+            }
+            if (lexer_.CurrentToken() == '{') {
+                vector<ast::DictLiteral::Item> items;
+                lexer_.NextToken();
+                while (lexer_.CurrentToken() != '}') {
+                    if (!items.empty()) {
+                        lexer_.Expect<TokenType::Char>(',');
+                        lexer_.NextToken();
+                    }
+                    auto key = ParseTest();
+                    lexer_.Expect<TokenType::Char>(':');
+                    lexer_.NextToken();
+                    items.emplace_back(std::move(key), ParseTest());
+                }
+                lexer_.NextToken();
+                return make_unique<ast::DictLiteral>(std::move(items));
+            }
             if (lexer_.CurrentToken() == '-') {
                 lexer_.NextToken();
-                return make_unique<ast::Mult>(ParseMult(), make_unique<ast::NumericConst>(-1));
+                return make_unique<ast::Mult>(ParseMult(), make_unique<ast::NumericConst>(-1, constants_count_++));
             }
             if (const auto* num = lexer_.CurrentToken().TryAs<TokenType::Number>()) {
-                int result = num->value;
+                int64_t result = num->value;
+                lexer_.NextToken();
+                return make_unique<ast::NumericConst>(result, constants_count_++);
+            }
+            if (const auto* num = lexer_.CurrentToken().TryAs<TokenType::BigNumber>()) {
+                runtime::BigInt result = runtime::BigInt::FromString(num->value);
                 lexer_.NextToken();
-                return make_unique<ast::NumericConst>(result);
+                return make_unique<ast::BigNumericConst>(std::move(result), constants_count_++);
             }
             if (const auto* str = lexer_.CurrentToken().TryAs<TokenType::String>()) {
                 string result = str->value;
                 lexer_.NextToken();
-                return make_unique<ast::StringConst>(std::move(result));
+                return make_unique<ast::StringConst>(std::move(result), constants_count_++);
             }
             if (lexer_.CurrentToken().Is<TokenType::True>()) {
                 lexer_.NextToken();
@@ -274,9 +415,8 @@ namespace {
                         make_unique<ast::VariableValue>(std::move(names)), std::move(method_name),
                         std::move(args));
                 }
-                if (auto it = declared_classes_.find(method_name); it != declared_classes_.end()) {
-                    return make_unique<ast::NewInstance>(
-                        static_cast<const runtime::Class&>(*it->second), std::move(args));  // NOLINT
+                if (const runtime::Class* cls = FindClass(method_name)) {
+                    return make_unique<ast::NewInstance>(*cls, std::move(args));
                 }
                 if (method_name == "str"sv) {
                     if (args.size() != 1) {
@@ -284,6 +424,13 @@ namespace {
                     }
                     return make_unique<ast::Stringify>(std::move(args.front()));
                 }
+                if (const runtime::Builtin* builtin = builtins_.Find(method_name)) {
+                    if (!builtin->AcceptsArgumentCount(args.size())) {
+                        throw ParseError("Function "s + method_name + " doesn't take "s + to_string(args.size())
+                                         + " arguments"s);
+                    }
+                    return make_unique<ast::BuiltinCall>(*builtin, std::move(args));
+                }
                 throw ParseError("Unknown call to "s + method_name + "()"s);
             }
             return make_unique<ast::VariableValue>(std::move(names));
@@ -325,12 +472,51 @@ namespace {
                 std::move(else_body));
         }
 
+        // Loop -> while LogicalExpr: Suite
+        unique_ptr<ast::Statement> ParseLoop()  // NOLINT
+        {
+            lexer_.Expect<TokenType::While>();
+            lexer_.NextToken();
+
+            auto condition = ParseTest();
+
+            lexer_.Expect<TokenType::Char>(':');
+            lexer_.NextToken();
+
+            ++loop_depth_;
+            auto body = ParseSuite();
+            --loop_depth_;
+
+            return make_unique<ast::While>(std::move(condition), std::move(body));
+        }
+
+        // ForLoop -> for id in Expr: Suite
+        unique_ptr<ast::Statement> ParseForLoop()  // NOLINT
+        {
+            lexer_.Expect<TokenType::For>();
+            string var = lexer_.ExpectNext<TokenType::Id>().value;
+            lexer_.ExpectNext<TokenType::In>();
+            lexer_.NextToken();
+
+            auto iterable = ParseTest();
+
+            lexer_.Expect<TokenType::Char>(':');
+            lexer_.NextToken();
+
+            ++loop_depth_;
+            auto body = ParseSuite();
+            --loop_depth_;
+
+            return make_unique<ast::ForLoop>(std::move(var), std::move(iterable), std::move(body));
+        }
+
         // LogicalExpr -> AndTest [OR AndTest]
         // AndTest -> NotTest [AND NotTest]
         // NotTest -> [NOT] NotTest
         //          | Comparison
         unique_ptr<ast::Statement> ParseTest()  // NOLINT
         {
+            CheckNesting();
             auto result = ParseAndTest();
             while (lexer_.CurrentToken().Is<TokenType::Or>()) {
                 lexer_.NextToken();
@@ -351,6 +537,7 @@ namespace {
 
         unique_ptr<ast::Statement> ParseNotTest()  // NOLINT
         {
+            CheckNesting();
             if (lexer_.CurrentToken().Is<TokenType::Not>()) {
                 lexer_.NextToken();
                 return make_unique<ast::Not>(ParseNotTest());  // NOLINT
@@ -401,8 +588,11 @@ namespace {
         // Statement -> SimpleStatement Newline
         //           | class ClassDefinition
         //           | if Condition
+        //           | while Loop
+        //           | for ForLoop
         unique_ptr<ast::Statement> ParseStatement()  // NOLINT
         {
+            CheckNesting();
             const auto& tok = lexer_.CurrentToken();
 
             if (tok.Is<TokenType::Class>()) {
@@ -412,6 +602,12 @@ namespace {
             if (tok.Is<TokenType::If>()) {
                 return ParseCondition();
             }
+            if (tok.Is<TokenType::While>()) {
+                return ParseLoop();
+            }
+            if (tok.Is<TokenType::For>()) {
+                return ParseForLoop();
+            }
             auto result = ParseSimpleStatement();
             lexer_.Expect<TokenType::Newline>();
             lexer_.NextToken();
@@ -420,11 +616,28 @@ namespace {
 
         // StatementBody -> return Expression
         //               | print ExpressionList
+        //               | break
+        //               | continue
         //               | AssignmentOrCall
         unique_ptr<ast::Statement> ParseSimpleStatement() {
             const auto& tok = lexer_.CurrentToken();
 
+            if (tok.Is<TokenType::Break>() || tok.Is<TokenType::Continue>()) {
+                if (loop_depth_ == 0) {
+                    throw ParseError("'break' and 'continue' are allowed only inside a loop"s);
+                }
+                const bool is_break = tok.Is<TokenType::Break>();
+                lexer_.NextToken();
+                if (is_break) {
+                    return make_unique<ast::Break>();
+                }
+                return make_unique<ast::Continue>();
+            }
+
             if (tok.Is<TokenType::Return>()) {
+                if (method_depth_ == 0) {
+                    throw ParseError("'return' is allowed only inside a method"s);
+                }
                 lexer_.NextToken();
                 return make_unique<ast::Return>(ParseTest());
             }
@@ -439,12 +652,31 @@ namespace {
             return ParseAssignmentOrCall();
         }
 
+        //  ,  , not    .  
+        //    ,    
+        void CheckNesting() const {
+            if (runtime::IsNativeStackExhausted()) {
+                throw ParseError("Maximum recursion depth exceeded: program is nested too deeply"s);
+            }
+        }
+
         parse::Lexer& lexer_;
+        const runtime::BuiltinRegistry& builtins_;
         runtime::Closure declared_classes_;
+        //         
+        size_t loop_depth_ = 0;
+        //    : return   - 
+        size_t method_depth_ = 0;
+        //   :   -      
+        size_t constants_count_ = 0;
     };
 
 }  // namespace
 
+unique_ptr<runtime::Executable> ParseProgram(parse::Lexer& lexer, const runtime::BuiltinRegistry& builtins) {
+    return Parser{ lexer, builtins }.ParseProgram();
+}
+
 unique_ptr<runtime::Executable> ParseProgram(parse::Lexer& lexer) {
-    return Parser{ lexer }.ParseProgram();
+    return ParseProgram(lexer, runtime::BuiltinRegistry::Standard());
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace parse {
 }
 
 namespace runtime {
+    class BuiltinRegistry;
     class Executable;
 }
 
@@ -15,4 +16,10 @@ struct ParseError : std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+//  .  ,      str(), 
+//  builtins,    ,     (, ).
+//      
+std::unique_ptr<runtime::Executable> ParseProgram(parse::Lexer& lexer, const runtime::BuiltinRegistry& builtins);
+
+//       (runtime::BuiltinRegistry::Standard)
 std::unique_ptr<runtime::Executable> ParseProgram(parse::Lexer& lexer);
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "lexer.h"
+#include "native.h"
 #include "parse.h"
+#include "program.h"
 #include "statement.h"
 #include "test_runner_p.h"
 
+#include <thread>
+
 using namespace std;
 
 namespace parse {
@@ -31,6 +35,27 @@ print x + y, z + n
         ASSERT_EQUAL(context.output.str(), "9 hello, world\n"s);
     }
 
+    void TestLongNumberLiterals() {
+        const string program = R"(
+x = 99999999999999999999
+print x, x + 1, x - x
+print -9223372036854775808, -9223372036854775808 - 1
+)"s;
+
+        runtime::DummyContext context;
+
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+            "99999999999999999999 100000000000000000000 0\n"
+            "-9223372036854775808 -9223372036854775809\n"s);
+        // ,    int64_t,   BigNumber,  ,
+        //   int64_t,   Number
+        ASSERT(closure.at("x"s).TryAs<runtime::BigNumber>() != nullptr);
+    }
+
     void TestProgramWithClasses() {
         const string program = R"(
 program_name = "Classes test"
@@ -266,10 +291,775 @@ x = X(xh)
         ASSERT_EQUAL(xh->Fields().at("x"s).Get(), closure.at("x"s).Get());
     }
 
+    void TestWhileLoop() {
+        const string program = R"(
+class Counter:
+  def first_multiple(n, limit):
+    i = 1
+    while i < limit:
+      if i / n * n == i:
+        return i
+      i = i + 1
+    return None
+
+i = 0
+total = 0
+while True:
+  i = i + 1
+  if i > 10:
+    break
+  if i / 2 * 2 == i:
+    continue
+  j = 0
+  while j < i:
+    j = j + 1
+    if j > 2:
+      break
+  total = total + j
+print total
+counter = Counter()
+print counter.first_multiple(7, 100), counter.first_multiple(7, 5)
+)"s;
+
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(), "13\n7 None\n"s);
+        ASSERT(context.GetCompletion() == runtime::Completion::NORMAL);
+    }
+
+    void TestLists() {
+        const string program = R"(
+class Stack:
+  def __init__():
+    self.items = []
+
+  def push(value):
+    self.items.append(value)
+
+  def __len__():
+    return len(self.items)
+
+squares = []
+i = 0
+while i < 5:
+  squares.append(i * i)
+  i = i + 1
+squares[0] = 'zero'
+grid = [[1, 2], [3, 4]]
+grid[1][0] = grid[0][1] + 10
+print squares, len(squares), squares[-1], grid
+print squares.pop(), squares.pop(0), squares
+s = Stack()
+s.push('x')
+print len(s), len('abc'), [] == [], [1, 'b'] < [1, 'c']
+if s and not []:
+  print str([None, True])
+)"s;
+
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "['zero', 1, 4, 9, 16] 5 16 [[1, 2], [12, 4]]\n"
+                     "16 zero [1, 4, 9]\n"
+                     "1 3 True True\n"
+                     "[None, True]\n"s);
+
+        auto run = [](const string& source) {
+            runtime::DummyContext context;
+            runtime::Closure closure;
+            ParseProgramFromString(source)->Execute(closure, context);
+            return context.output.str();
+        };
+        ASSERT_THROWS(run("x = [1]\nprint x[1]\n"s), std::runtime_error);
+        ASSERT_THROWS(run("x = 5\nx[0] = 1\n"s), std::runtime_error);
+        ASSERT_THROWS(run("x = []\nx.pop()\n"s), std::runtime_error);
+
+        //  ,     ,   
+        const string mutator = R"(
+class Mutator:
+  def __init__(l):
+    self.l = l
+
+  def __str__():
+    i = 0
+    while i < 100:
+      self.l.append(i)
+      i += 1
+    return 'mutator'
+
+  def __eq__(other):
+    while len(self.l) > 0:
+      self.l.pop()
+    return True
+
+l = []
+)"s;
+        string expected = "[mutator, 1"s;
+        for (int i = 0; i < 100; ++i) {
+            expected += ", "s + to_string(i);
+        }
+        ASSERT_EQUAL(run(mutator + "l.append(Mutator(l))\nl.append(1)\nprint l\n"s), expected + "]\n"s);
+        ASSERT_EQUAL(run(mutator + "l.append(Mutator(l))\nl.append(1)\nm = [l[0], 1]\nprint l == m, l\n"s),
+                     "False []\n"s);
+    }
+
+    void TestDicts() {
+        const string program = R"(
+class Point:
+  def __init__(x, y):
+    self.x = x
+    self.y = y
+
+  def __hash__():
+    return self.x * 31 + self.y
+
+  def __eq__(other):
+    return self.x == other.x and self.y == other.y
+
+ages = {'bob': 30, 'alice': 25}
+ages['carol'] = 41
+ages['bob'] = ages['bob'] + 1
+print ages, len(ages), ages.get('dave'), ages.get('dave', 0)
+print ages.pop('alice'), ages.keys(), ages.values()
+names = {}
+names[Point(1, 2)] = 'a'
+names[Point(1, 2)] = 'b'
+print len(names), names[Point(1, 2)], {1: [2]} == {1: [2]}, {} != {True: 1}
+)"s;
+
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "{'bob': 31, 'alice': 25, 'carol': 41} 3 None 0\n"
+                     "25 ['bob', 'carol'] [31, 41]\n"
+                     "1 b True True\n"s);
+
+        auto run = [](const string& source) {
+            runtime::DummyContext context;
+            runtime::Closure closure;
+            ParseProgramFromString(source)->Execute(closure, context);
+            return context.output.str();
+        };
+        ASSERT_THROWS(run("d = {'a': 1}\nprint d['b']\n"s), std::runtime_error);
+        ASSERT_THROWS(run("d = {[1]: 1}\n"s), std::runtime_error);
+
+        //    ,   ,   ,   
+        const string filler = R"(
+class Filler:
+  def __init__(d):
+    self.d = d
+
+  def fill():
+    i = 0
+    while i < 100:
+      self.d[i] = i
+      i += 1
+
+  def __hash__():
+    return 1
+
+  def __eq__(other):
+    self.fill()
+    return True
+
+  def __str__():
+    self.fill()
+    return 'filler'
+
+d = {}
+)"s;
+        ASSERT_THROWS(run(filler + "d[Filler(d)] = 1\nprint d[Filler(d)]\n"s), std::runtime_error);
+
+        string expected = "{'x': filler"s;
+        for (int i = 0; i < 100; ++i) {
+            expected += ", "s + to_string(i) + ": "s + to_string(i);
+        }
+        ASSERT_EQUAL(run(filler + "d['x'] = Filler(d)\nprint d\n"s), expected + "}\n"s);
+
+        ASSERT_EQUAL(run(filler + "e = {}\nd['x'] = Filler(d)\ne['x'] = Filler(e)\nd['y'] = 1\ne['y'] = 1\nprint d == e\n"s),
+                     "True\n"s);
+    }
+
+    void TestStrings() {
+        const string program = R"(
+log = ['2024-01-01 INFO start', '2024-01-01 ERROR disk full: /dev/sda', '2024-01-02 WARN slow', '2024-01-02 ERROR timeout']
+counts = {}
+errors = []
+i = 0
+while i < len(log):
+  parts = log[i].split(' ')
+  level = parts[1]
+  counts[level] = counts.get(level, 0) + 1
+  if log[i].find('ERROR') >= 0:
+    errors.append(' '.join(parts[2:]).upper())
+  i = i + 1
+print counts, errors
+s = 'mython'
+print s[0], s[-1], s[1:3], s[:2], s[4:], s[-3:], s[3:1] == '', [1, 2, 3][1:]
+print 'a-b'.split('-')[1], s.startswith('my'), 'X'.lower()
+)"s;
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "{'INFO': 1, 'ERROR': 2, 'WARN': 1} ['DISK FULL: /DEV/SDA', 'TIMEOUT']\n"
+                     "m n yt my on hon True [2, 3]\n"
+                     "b True x\n"s);
+    }
+
+    void TestBuiltinFunctions() {
+        const string program = R"(
+xs = range(5)
+print len(xs), list(range(1, 7, 2)), list(range(3, 0, -1)), list(range(0)), xs, range(1, 7, 2)
+print int('-42') + 1, int(' 123456789012345678901234567890 '), int(True), abs(-7), abs(7)
+print min(3, 1, 2), max(xs), min(['b', 'a']), max(-9223372036854775807 - 1, 0)
+print abs(-9223372036854775807 - 1), square(12)
+)"s;
+        runtime::BuiltinRegistry builtins = runtime::BuiltinRegistry::WithStandardFunctions();
+        builtins.Register("square"s, [](vector<runtime::ObjectHolder>& args, runtime::Context&) {
+            const int64_t value = args.front().TryAs<runtime::Number>()->GetValue();
+            return runtime::ObjectHolder::Own(runtime::Number{ value * value });
+        }, 1);
+
+        istringstream input(program);
+        parse::Lexer lexer(input);
+        auto tree = ParseProgram(lexer, builtins);
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "5 [1, 3, 5] [3, 2, 1] [] range(0, 5) range(1, 7, 2)\n"
+                     "-41 123456789012345678901234567890 1 7 7\n"
+                     "1 4 a 0\n"
+                     "9223372036854775808 144\n"s);
+
+        // ,    ,     -  
+        ASSERT_THROWS(ParseProgramFromString("print square(2)\n"s), ParseError);
+        ASSERT_THROWS(ParseProgramFromString("print len(1, 2)\n"s), ParseError);
+        ASSERT_THROWS(ParseProgramFromString("print max()\n"s), ParseError);
+        runtime::DummyContext error_context;
+        ASSERT_THROWS(ParseProgramFromString("print int('12a')\n"s)->Execute(closure, error_context),
+                      std::runtime_error);
+    }
+
+    void TestAugmentedAssignment() {
+        const string program = R"(
+class Counter:
+  def __init__():
+    self.value = 0
+    self.items = []
+
+  def __iadd__(item):
+    self.items.append(item)
+    self.value += 1
+    return self
+
+class Point:
+  def __init__(x):
+    self.x = x
+
+  def __add__(other):
+    return self.x + other
+
+i = 0
+total = 0
+while i < 10:
+  i += 1
+  total += i * i
+total -= 5
+total *= 2
+total /= 3
+s = 'a'
+t = s
+s += 'b'
+s += str(i)
+c = Counter()
+d = c
+c += 'x'
+c += 'y'
+p = Point(1)
+q = p
+p += 10
+c.value *= 100
+c.value -= 1
+big = 9223372036854775807
+big += 1
+print i, total, s, t, c.value, c.items, d.value, p, q.x, big
+)"s;
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        // t  q    ,   s  p     
+        ASSERT_EQUAL(context.output.str(), "10 253 ab10 a 199 ['x', 'y'] 199 11 1 9223372036854775808\n"s);
+
+        runtime::DummyContext error_context;
+        ASSERT_THROWS(ParseProgramFromString("x += 1\n"s)->Execute(closure, error_context), std::runtime_error);
+        ASSERT_THROWS(ParseProgramFromString("s = 'a'\ns -= 'b'\n"s)->Execute(closure, error_context),
+                      std::runtime_error);
+        ASSERT_THROWS(ParseProgramFromString("n = 1\nn /= 0\n"s)->Execute(closure, error_context),
+                      std::runtime_error);
+    }
+
+    void TestOperatorOverloading() {
+        const string program = R"(
+class Scale:
+  def __init__(k):
+    self.k = k
+
+  def __mul__(x):
+    return x * self.k
+
+  def __rmul__(x):
+    return x * self.k
+
+  def __rsub__(x):
+    return x - self.k
+
+  def __truediv__(x):
+    return self.k / x
+
+  def __radd__(x):
+    return x + self.k
+
+class Log:
+  def __init__():
+    self.calls = 0
+
+  def next():
+    self.calls += 1
+    return Scale(self.calls)
+
+s = Scale(3)
+log = Log()
+x = 5
+x *= s
+t = 1 + log.next()
+print s * 2, 2 * s, 10 - s, s / 2, 1 + s, x, t, log.calls
+)"s;
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        //      ,  log.next()  
+        ASSERT_EQUAL(context.output.str(), "6 6 7 1 4 15 2 1\n"s);
+        runtime::DummyContext error_context;
+        ASSERT_THROWS(ParseProgramFromString("class A:\n  def f():\n    return 1\nprint A() - 1\n"s)
+                          ->Execute(closure, error_context), std::runtime_error);
+    }
+
+    void TestForLoop() {
+        const string program = R"(
+class Countdown:
+  def __init__(start):
+    self.current = start
+
+  def __iter__():
+    return self
+
+  def __next__():
+    if self.current == 0:
+      return None
+    self.current -= 1
+    return self.current + 1
+
+class Bag:
+  def __init__():
+    self.items = ['x', 'y']
+
+  def __iter__():
+    return self.items
+
+squares = []
+for i in range(5):
+  squares.append(i * i)
+total = 0
+for i in range(100, 0, -7):
+  if i > 50:
+    continue
+  if i < 10:
+    break
+  total += i
+print squares, total, i
+chars = ''
+for c in 'abc':
+  chars = c + chars
+ages = {'ann': 30, 'bob': 25}
+for name in ages:
+  print name, ages[name]
+for n in Countdown(3):
+  print n
+for item in Bag():
+  print item
+last = 'unchanged'
+for last in []:
+  print 'never'
+for x in [[1, 2], [3]]:
+  for y in x:
+    total += y
+print chars, last, total, max(range(3)), min('zya'), len(range(0, 10, 3)), range(0, 10, 3)[-1]
+)"s;
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "[0, 1, 4, 9, 16] 150 9\n"
+                     "ann 30\nbob 25\n"
+                     "3\n2\n1\n"
+                     "x\ny\n"
+                     "cba unchanged 156 2 a 4 9\n"s);
+
+        runtime::DummyContext error_context;
+        ASSERT_THROWS(ParseProgramFromString("for x in 5:\n  print x\n"s)->Execute(closure, error_context),
+                      std::runtime_error);
+        //            
+        ASSERT_THROWS(ParseProgramFromString(R"(
+d = {1: 1, 2: 2, 3: 3, 4: 4, 5: 5, 6: 6, 7: 7}
+for k in d:
+  if k == 5:
+    d.pop(1)
+    d[100] = 0
+)"s)->Execute(closure, error_context), std::runtime_error);
+        ASSERT_THROWS(ParseProgramFromString("for x in range(3) print x\n"s), parse::LexerError);
+    }
+
+    struct Vec {
+        int64_t x = 0;
+        int64_t y = 0;
+    };
+
+    void TestNativeClasses() {
+        using runtime::NativeArgs;
+        using runtime::ObjectHolder;
+
+        const runtime::Class* vec_class = nullptr;
+        auto number = [](int64_t value) {
+            return ObjectHolder::Own(runtime::Number{ value });
+        };
+        ObjectHolder vec = runtime::NativeClassBuilder<Vec>("Vec"s)
+            .Method("__init__"s, 2, [](Vec& v, const NativeArgs& args, runtime::Context&) {
+                v = { args.GetNumber(0), args.GetNumber(1) };
+                return ObjectHolder::None();
+            })
+            .Method("x"s, 0, [number](Vec& v, const NativeArgs&, runtime::Context&) {
+                return number(v.x);
+            })
+            .Method("y"s, 0, [number](Vec& v, const NativeArgs&, runtime::Context&) {
+                return number(v.y);
+            })
+            .Method("__add__"s, 1, [&vec_class](Vec& v, const NativeArgs& args, runtime::Context&) {
+                const Vec& other = runtime::GetNativeArgument<Vec>(args, 0);
+                return runtime::MakeNativeInstance(*vec_class, Vec{ v.x + other.x, v.y + other.y });
+            })
+            .Method("__eq__"s, 1, [](Vec& v, const NativeArgs& args, runtime::Context&) {
+                const Vec& other = runtime::GetNativeArgument<Vec>(args, 0);
+                return runtime::MakeBool(v.x == other.x && v.y == other.y);
+            })
+            .Method("__lt__"s, 1, [](Vec& v, const NativeArgs& args, runtime::Context&) {
+                const Vec& other = runtime::GetNativeArgument<Vec>(args, 0);
+                return runtime::MakeBool(v.x < other.x || (v.x == other.x && v.y < other.y));
+            })
+            .Method("__str__"s, 0, [](Vec& v, const NativeArgs&, runtime::Context&) {
+                return ObjectHolder::Own(runtime::String{ "("s + to_string(v.x) + ", "s + to_string(v.y) + ")"s });
+            })
+            .Build();
+        vec_class = vec.TryAs<runtime::Class>();
+
+        runtime::BuiltinRegistry builtins = runtime::BuiltinRegistry::WithStandardFunctions();
+        builtins.RegisterClass(vec);
+
+        const string program = R"(
+class Named(Vec):
+  def set_name(name):
+    self.name = name
+
+  def __str__():
+    return self.name + str(self.x())
+
+a = Vec(1, 2)
+b = Vec(3, 4)
+print a + b, a == Vec(1, 2), a < b, a > b, (a + b).x()
+n = Named(5, 6)
+n.set_name('n')
+print n, n.y(), n == Vec(5, 6), Vec(0, 0) < n, a + n
+)"s;
+        istringstream input(program);
+        parse::Lexer lexer(input);
+        auto tree = ParseProgram(lexer, builtins);
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(),
+                     "(4, 6) True True False 4\n"
+                     "n5 6 True True (6, 8)\n"s);
+
+        istringstream bad_input("print Vec(1, 2) + 3\n"s);
+        parse::Lexer bad_lexer(bad_input);
+        runtime::DummyContext error_context;
+        ASSERT_THROWS(ParseProgram(bad_lexer, builtins)->Execute(closure, error_context), std::runtime_error);
+    }
+
+    void TestTailRecursion() {
+        const string program = R"(
+class Math:
+  def sum(n, acc):
+    if n == 0:
+      return acc
+    local = n
+    return self.sum(n - 1, self.add(acc, local))
+  def add(a, b):
+    return self.add_impl(b, a)
+  def add_impl(a, b):
+    return a + b
+  def is_even(n):
+    if n == 0:
+      return True
+    return self.is_odd(n - 1)
+  def is_odd(n):
+    if n == 0:
+      return False
+    return self.is_even(n - 1)
+
+m = Math()
+print m.sum(1000000, 0)
+print m.is_even(300001), m.is_odd(300001)
+)"s;
+
+        runtime::DummyContext context;
+        runtime::Closure closure;
+        auto tree = ParseProgramFromString(program);
+        tree->Execute(closure, context);
+
+        ASSERT_EQUAL(context.output.str(), "500000500000\nFalse True\n"s);
+        ASSERT_EQUAL(context.GetCallStack().GetDepth(), 0U);
+        ASSERT(context.GetTailCallArgs().empty());
+    }
+
+    void TestRecursionLimits() {
+        const string program = R"(
+class A:
+  def depth(n):
+    if n == 0:
+      return 0
+    return 1 + self.depth(n - 1)
+
+a = A()
+print a.depth(n)
+)"s;
+        auto tree = ParseProgramFromString(program);
+
+        auto run = [&tree](int n, size_t max_depth) {
+            runtime::DummyContext context;
+            context.GetCallStack().SetMaxDepth(max_depth);
+            runtime::Closure closure;
+            closure["n"s] = runtime::ObjectHolder::Own(runtime::Number{ n });
+            try {
+                tree->Execute(closure, context);
+            }
+            catch (const runtime_error&) {
+                ASSERT_EQUAL(context.GetCallStack().GetDepth(), 0U);
+                throw;
+            }
+            return context.output.str();
+        };
+
+        ASSERT_EQUAL(run(10, 11), "10\n"s);
+        ASSERT_THROWS(run(10, 10), runtime_error);
+
+        //       runtime_error,     
+        ASSERT_THROWS(runtime::RunWithStackSize(1024 * 1024, [&run] { run(1'000'000, 10'000'000); }), runtime_error);
+
+        //         
+        string output;
+        runtime::RunWithStackSize(size_t{ 64 } * 1024 * 1024, [&run, &output] { output = run(50'000, 100'000); });
+        ASSERT_EQUAL(output, "50000\n"s);
+    }
+
+    void TestNestingLimits() {
+        //  task    1      
+        auto error_on_small_stack = [](const function<void()>& task) {
+            try {
+                runtime::RunWithStackSize(1024 * 1024, task);
+            }
+            catch (const runtime_error& e) {
+                return string(e.what());
+            }
+            return ""s;
+        };
+        auto is_depth_error = [](const string& message) {
+            return message.rfind("Maximum recursion depth exceeded"s, 0) == 0;
+        };
+        auto parse = [](const string& source) {
+            return [source] {
+                ParseProgramFromString(source);
+            };
+        };
+
+        //       -  ,    
+        const int depth = 20'000;
+        ASSERT(is_depth_error(error_on_small_stack(parse("x = "s + string(depth, '(') + "1"s + string(depth, ')') + "\n"s))));
+        ASSERT(is_depth_error(error_on_small_stack(parse("x = "s + string(depth, '[') + string(depth, ']') + "\n"s))));
+        ASSERT(is_depth_error(error_on_small_stack(parse("x = "s + string(depth, '-') + "1\n"s))));
+
+        //    ,    
+        string chain = "x = 1"s;
+        for (int i = 0; i < depth; ++i) {
+            chain += " + 1"s;
+        }
+        auto tree = ParseProgramFromString(chain + "\n"s);
+        ASSERT(is_depth_error(error_on_small_stack([&tree] {
+            runtime::DummyContext context;
+            runtime::Closure closure;
+            tree->Execute(closure, context);
+        })));
+
+        //         ,   
+        //      
+        const string lists = R"(
+l = []
+m = []
+i = 0
+while i < 100000:
+  l = [l]
+  m = [m]
+  i += 1
+)"s;
+        auto run = [&lists](const string& statement) {
+            return [source = lists + statement] {
+                runtime::DummyContext context;
+                runtime::Closure closure;
+                ParseProgramFromString(source)->Execute(closure, context);
+            };
+        };
+        ASSERT_EQUAL(error_on_small_stack(run(""s)), ""s);
+        ASSERT(is_depth_error(error_on_small_stack(run("print l\n"s))));
+        ASSERT(is_depth_error(error_on_small_stack(run("x = str(l)\n"s))));
+        ASSERT(is_depth_error(error_on_small_stack(run("x = l == m\n"s))));
+        ASSERT(is_depth_error(error_on_small_stack(run("x = l < m\n"s))));
+    }
+
+    void TestCompiledProgram() {
+        const Program program = Program::Compile(R"--(
+class Point:
+  def __init__(x, y):
+    self.x = x
+    self.y = y
+  def __str__():
+    return "(" + str(self.x) + ", " + str(self.y) + ")"
+  def __add__(other):
+    self.x = self.x + other.x
+    self.y = self.y + other.y
+    return self
+
+total = Point(0, 0)
+for i in range(start, start + 100):
+  total = total + Point(i, 1)
+  total.x += 1
+label = "total"
+label += ":"
+print label, total
+start = start + 1
+)--"sv);
+        auto expected = [](int start) {
+            return "total: ("s + to_string(100 * start + 4950 + 100) + ", 100)\n"s;
+        };
+
+        //     ,     
+        {
+            runtime::DummyContext context;
+            runtime::Closure globals = { {"start"s, runtime::ObjectHolder::Own(runtime::Number{ 1 })} };
+            program.Run(context, globals);
+            program.Run(context, globals);
+            ASSERT_EQUAL(context.output.str(), expected(1) + expected(2));
+        }
+
+        //      ,      
+        constexpr int threads_count = 8;
+        vector<string> outputs(threads_count);
+        vector<thread> threads;
+        for (int t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&program, &outputs, t] {
+                runtime::DummyContext context;
+                runtime::Closure globals = { {"start"s, runtime::ObjectHolder::Own(runtime::Number{ t * 1000 })} };
+                for (int run = 0; run < 20; ++run) {
+                    program.Run(context, globals);
+                }
+                outputs[t] = context.output.str();
+            });
+        }
+        for (thread& worker : threads) {
+            worker.join();
+        }
+        for (int t = 0; t < threads_count; ++t) {
+            string expected_output;
+            for (int run = 0; run < 20; ++run) {
+                expected_output += expected(t * 1000 + run);
+            }
+            ASSERT_EQUAL(outputs[t], expected_output);
+        }
+
+        // ,    ,   
+        runtime::Closure globals;
+        {
+            runtime::DummyContext context;
+            Program::Compile("greeting = 'hello'\nanswer = 42\n"sv).Run(context, globals);
+        }
+        runtime::DummyContext context;
+        Program::Compile("print greeting, answer\n"sv).Run(context, globals);
+        ASSERT_EQUAL(context.output.str(), "hello 42\n"s);
+
+        // ,    return   ,   Run
+        ast::Return(make_unique<ast::NumericConst>(1)).Execute(globals, context);
+        ASSERT(context.GetCompletion() == runtime::Completion::RETURN);
+        Program::Compile("print 'a'\nif answer:\n  print 'b'\nprint 'c'\n"sv).Run(context, globals);
+        ASSERT_EQUAL(context.output.str(), "hello 42\na\nb\nc\n"s);
+
+        ASSERT_THROWS((void)Program::Compile("break\n"sv), ParseError);
+    }
+
+    void TestBreakOutsideLoop() {
+        ASSERT_THROWS(ParseProgramFromString("break\n"s), ParseError);
+        ASSERT_THROWS(ParseProgramFromString(R"(
+while True:
+  class A:
+    def f():
+      continue
+)"s), ParseError);
+    }
+
+    void TestReturnOutsideMethod() {
+        ASSERT_THROWS(ParseProgramFromString("print 1\nreturn 5\nprint 2\n"s), ParseError);
+        ASSERT_THROWS(ParseProgramFromString(R"(
+class A:
+  def f():
+    return 1
+if True:
+  return 2
+)"s), ParseError);
+    }
+
 }  // namespace parse
 
 void TestParseProgram(TestRunner& tr) {
     RUN_TEST(tr, parse::TestSimpleProgram);
+    RUN_TEST(tr, parse::TestLongNumberLiterals);
     RUN_TEST(tr, parse::TestProgramWithClasses);
     RUN_TEST(tr, parse::TestProgramWithIf);
     RUN_TEST(tr, parse::TestReturnFromIf);
@@ -278,4 +1068,19 @@ void TestParseProgram(TestRunner& tr) {
     RUN_TEST(tr, parse::TestComplexLogicalExpression);
     RUN_TEST(tr, parse::TestClassicalPolymorphism);
     RUN_TEST(tr, parse::TestSelf);
+    RUN_TEST(tr, parse::TestWhileLoop);
+    RUN_TEST(tr, parse::TestLists);
+    RUN_TEST(tr, parse::TestDicts);
+    RUN_TEST(tr, parse::TestStrings);
+    RUN_TEST(tr, parse::TestBuiltinFunctions);
+    RUN_TEST(tr, parse::TestNativeClasses);
+    RUN_TEST(tr, parse::TestAugmentedAssignment);
+    RUN_TEST(tr, parse::TestOperatorOverloading);
+    RUN_TEST(tr, parse::TestForLoop);
+    RUN_TEST(tr, parse::TestBreakOutsideLoop);
+    RUN_TEST(tr, parse::TestReturnOutsideMethod);
+    RUN_TEST(tr, parse::TestTailRecursion);
+    RUN_TEST(tr, parse::TestRecursionLimits);
+    RUN_TEST(tr, parse::TestNestingLimits);
+    RUN_TEST(tr, parse::TestCompiledProgram);
 }
\ No newline at end of file
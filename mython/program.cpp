@@ -0,0 +1,36 @@
+#include "program.h"
+
+#include "lexer.h"
+#include "parse.h"
+#include "runtime.h"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+Program::Program(shared_ptr<runtime::Executable> body)
+    : body_(move(body))
+{}
+
+Program Program::Compile(string_view source) {
+    istringstream input{ string(source) };
+    return Compile(input);
+}
+
+Program Program::Compile(istream& input) {
+    parse::Lexer lexer(input);
+    return Program(ParseProgram(lexer));
+}
+
+Program Program::Compile(istream& input, const runtime::BuiltinRegistry& builtins) {
+    parse::Lexer lexer(input);
+    return Program(ParseProgram(lexer, builtins));
+}
+
+void Program::Run(runtime::Context& context, runtime::Closure& globals) const {
+    //       ,   return
+    // (,      - )
+    context.ResetCompletion();
+    body_->Execute(globals, context);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
+namespace runtime {
+    class BuiltinRegistry;
+    class Closure;
+    class Context;
+    class Executable;
+}
+
+/*
+ *   Mython,       .
+ *
+ *    :    (,  , ,
+ *  ,  )     Run    
+ * .  Run      ,   
+ *   context  globals.        
+ *  ,    .
+ *
+ *        ,    
+ *    :      , True  False  
+ * ,       (. ast::ValueStatement). 
+ *     ,   :   
+ * (. CycleCollector)       .
+ *     ,      .
+ *
+ *  Program    
+ */
+class Program {
+public:
+    //      .
+    //    parse::LexerError  ParseError
+    [[nodiscard]] static Program Compile(std::string_view source);
+    [[nodiscard]] static Program Compile(std::istream& input);
+    //  ,      builtins.     
+    [[nodiscard]] static Program Compile(std::istream& input, const runtime::BuiltinRegistry& builtins);
+
+    //  .        globals,
+    //  print   context.GetOutput().     ,
+    //         return
+    void Run(runtime::Context& context, runtime::Closure& globals) const;
+
+private:
+    explicit Program(std::shared_ptr<runtime::Executable> body);
+
+    std::shared_ptr<runtime::Executable> body_;
+};
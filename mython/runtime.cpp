@@ -1,18 +1,174 @@
 #include "runtime.h"
 
+#include "bigint.h"
+#include "collections.h"
+
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <optional>
 #include <sstream>
 #include <algorithm>
 
+#include <pthread.h>
+
 using namespace std;
 
 namespace runtime {
     namespace {
         const std::string INIT_METHOD = "__init__"s;
         const std::string STR_METHOD = "__str__"s;
+        const std::string BOOL_METHOD = "__bool__"s;
+        const std::string LEN_METHOD = "__len__"s;
         const std::string LT_METHOD = "__lt__"s;
         const std::string EQ_METHOD = "__eq__"s;
+        const std::string NE_METHOD = "__ne__"s;
+        const std::string GT_METHOD = "__gt__"s;
+        const std::string LE_METHOD = "__le__"s;
+        const std::string GE_METHOD = "__ge__"s;
+        const std::string HASH_METHOD = "__hash__"s;
+        const std::string SELF = "self"s;
+
+        DunderCaches dunder_caches;
+
+        //    -.     
+        std::atomic<uint64_t> next_class_id{ 1 };
+
+        Bool true_value{ true };
+        Bool false_value{ false };
+
+        //   ,      CheckNativeStack
+        // ( , ,  )
+        constexpr size_t NATIVE_STACK_RESERVE = 256 * 1024;
+
+        // ,       ; 0 -   .
+        //   ,        
+        thread_local uintptr_t native_stack_limit = 0;
+
+        //  native_stack_limit.    ,    
+        uintptr_t ComputeNativeStackLimit() {
+            uintptr_t result = 1;
+#ifdef __linux__
+            pthread_attr_t attr;
+            if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+                void* stack_addr = nullptr;
+                size_t stack_size = 0;
+                if (pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0) {
+                    result = reinterpret_cast<uintptr_t>(stack_addr)
+                        + std::min(NATIVE_STACK_RESERVE, stack_size / 4);
+                }
+                pthread_attr_destroy(&attr);
+            }
+#endif
+            return result;
+        }
+
+        //   CacheCountingScope.       
+        atomic<size_t> cache_counting_scopes{ 0 };
+
+        void Count(atomic<size_t>& counter) {
+            if (cache_counting_scopes.load(memory_order_relaxed) != 0) {
+                counter.fetch_add(1, memory_order_relaxed);
+            }
+        }
+    }
+
+    CacheCountingScope::CacheCountingScope() {
+        cache_counting_scopes.fetch_add(1, memory_order_relaxed);
+    }
+
+    CacheCountingScope::~CacheCountingScope() {
+        cache_counting_scopes.fetch_sub(1, memory_order_relaxed);
+    }
+
+    const Method* InlineCache::Lookup(const Class& cls, const std::string& name) {
+        const uint64_t class_id = cls.GetId();
+        const size_t size = size_.load(memory_order_acquire);
+        if (size <= MAX_ENTRIES) {
+            for (size_t i = 0; i < size; ++i) {
+                if (entries_[i].class_id.load(memory_order_acquire) == class_id) {
+                    Count(hits_);
+                    return entries_[i].method.load(memory_order_relaxed);
+                }
+            }
+        }
+        Count(misses_);
+        const Method* method = cls.GetMethod(name);
+        if (size <= MAX_ENTRIES) {
+            //          .
+            //        ,    ,  
+            const size_t index = size_.fetch_add(1, memory_order_relaxed);
+            if (index < MAX_ENTRIES) {
+                entries_[index].method.store(method, memory_order_relaxed);
+                entries_[index].class_id.store(class_id, memory_order_release);
+            }
+        }
+        return method;
+    }
+
+    InlineCache::State InlineCache::GetState() const {
+        const size_t size = size_.load(memory_order_relaxed);
+        if (size > MAX_ENTRIES) {
+            return State::MEGAMORPHIC;
+        }
+        if (size == 0) {
+            return State::UNINITIALIZED;
+        }
+        return size == 1 ? State::MONOMORPHIC : State::POLYMORPHIC;
+    }
+
+    size_t InlineCache::GetHits() const {
+        return hits_.load(memory_order_relaxed);
+    }
+
+    size_t InlineCache::GetMisses() const {
+        return misses_.load(memory_order_relaxed);
+    }
+
+    const DunderCaches& GetDunderCaches() {
+        return dunder_caches;
+    }
+
+    ObjectHolder* FieldCache::Find(ClassInstance& instance, const std::string& name) {
+        const Shape* shape = instance.GetShape();
+        const uint64_t class_id = instance.GetClass().GetId();
+        const size_t size = size_.load(memory_order_acquire);
+        if (shape && size <= MAX_ENTRIES) {
+            for (size_t i = 0; i < size; ++i) {
+                if (entries_[i].class_id.load(memory_order_acquire) == class_id
+                    && entries_[i].shape.load(memory_order_relaxed) == shape) {
+                    Count(hits_);
+                    return &instance.GetSlot(entries_[i].slot.load(memory_order_relaxed));
+                }
+            }
+        }
+        Count(misses_);
+        //       ,        
+        if (!shape) {
+            return instance.FindField(name);
+        }
+        const size_t slot = shape->FindSlot(name);
+        if (slot == Shape::NO_SLOT) {
+            return nullptr;
+        }
+        if (size <= MAX_ENTRIES) {
+            const size_t index = size_.fetch_add(1, memory_order_relaxed);
+            if (index < MAX_ENTRIES) {
+                entries_[index].shape.store(shape, memory_order_relaxed);
+                entries_[index].slot.store(slot, memory_order_relaxed);
+                entries_[index].class_id.store(class_id, memory_order_release);
+            }
+        }
+        return &instance.GetSlot(slot);
+    }
+
+    size_t FieldCache::GetHits() const {
+        return hits_.load(memory_order_relaxed);
+    }
+
+    size_t FieldCache::GetMisses() const {
+        return misses_.load(memory_order_relaxed);
     }
 
     ObjectHolder::ObjectHolder(std::shared_ptr<Object> data)
@@ -24,8 +180,8 @@ namespace runtime {
     }
 
     ObjectHolder ObjectHolder::Share(Object& object) {
-        //   shared_ptr ( deleter   )
-        return ObjectHolder(std::shared_ptr<Object>(&object, [](auto* /*p*/) { /* do nothing */ }));
+        //   shared_ptr    (aliasing-   )
+        return ObjectHolder(std::shared_ptr<Object>(std::shared_ptr<Object>(), &object));
     }
 
     ObjectHolder ObjectHolder::None() {
@@ -46,35 +202,324 @@ namespace runtime {
         return data_.get();
     }
 
+    TypeTag ObjectHolder::GetTypeTag() const {
+        return data_ ? data_->GetTypeTag() : TypeTag::NONE;
+    }
+
     ObjectHolder::operator bool() const {
         return Get() != nullptr;
     }
 
+    bool ObjectHolder::IsOwning() const {
+        return data_.use_count() != 0;
+    }
+
+    bool ObjectHolder::IsUnique() const {
+        return data_.use_count() == 1;
+    }
+
+    ObjectHolder GcObject::GetHolder() {
+        if (std::shared_ptr<GcObject> owner = weak_from_this().lock()) {
+            return ObjectHolder(std::move(owner));
+        }
+        return ObjectHolder::Share(*this);
+    }
+
+    Closure::Closure(std::initializer_list<value_type> entries) {
+        for (const auto& [name, value] : entries) {
+            (*this)[name] = value;
+        }
+    }
+
+    Closure::iterator Closure::begin() {
+        return entries_.begin();
+    }
+
+    Closure::iterator Closure::end() {
+        return entries_.end();
+    }
+
+    Closure::const_iterator Closure::begin() const {
+        return entries_.begin();
+    }
+
+    Closure::const_iterator Closure::end() const {
+        return entries_.end();
+    }
+
+    size_t Closure::size() const {
+        return entries_.size();
+    }
+
+    bool Closure::empty() const {
+        return entries_.empty();
+    }
+
+    size_t Closure::FindPosition(const std::string& name) const {
+        if (index_.empty()) {
+            for (size_t pos = 0; pos < entries_.size(); ++pos) {
+                if (entries_[pos].first == name) {
+                    return pos;
+                }
+            }
+            return NO_POSITION;
+        }
+        const size_t mask = index_.size() - 1;
+        for (size_t cell = std::hash<std::string>{}(name) & mask; index_[cell] != 0; cell = (cell + 1) & mask) {
+            const size_t pos = index_[cell] - 1;
+            if (entries_[pos].first == name) {
+                return pos;
+            }
+        }
+        return NO_POSITION;
+    }
+
+    void Closure::AddToIndex(size_t position) {
+        const size_t mask = index_.size() - 1;
+        size_t cell = std::hash<std::string>{}(entries_[position].first) & mask;
+        while (index_[cell] != 0) {
+            cell = (cell + 1) & mask;
+        }
+        index_[cell] = static_cast<uint32_t>(position + 1);
+    }
+
+    void Closure::RebuildIndex() {
+        index_.clear();
+        if (entries_.size() < INDEX_THRESHOLD) {
+            return;
+        }
+        size_t capacity = INDEX_THRESHOLD * 2;
+        while (capacity < entries_.size() * 2) {
+            capacity *= 2;
+        }
+        index_.assign(capacity, 0);
+        for (size_t pos = 0; pos < entries_.size(); ++pos) {
+            AddToIndex(pos);
+        }
+    }
+
+    Closure::iterator Closure::find(const std::string& name) {
+        size_t pos = FindPosition(name);
+        return pos == NO_POSITION ? entries_.end() : entries_.begin() + pos;
+    }
+
+    Closure::const_iterator Closure::find(const std::string& name) const {
+        size_t pos = FindPosition(name);
+        return pos == NO_POSITION ? entries_.end() : entries_.begin() + pos;
+    }
+
+    ObjectHolder* Closure::FindWithHint(const std::string& name, ClosureHint& hint) {
+        size_t position = hint.Load();
+        ObjectHolder* value = FindWithHint(name, position);
+        //  ,    :       
+        if (value && position != hint.Load()) {
+            hint.Store(position);
+        }
+        return value;
+    }
+
+    ObjectHolder* Closure::FindWithHint(const std::string& name, size_t& hint) {
+        if (hint < entries_.size() && entries_[hint].first == name) {
+            return &entries_[hint].second;
+        }
+        size_t pos = FindPosition(name);
+        if (pos == NO_POSITION) {
+            return nullptr;
+        }
+        hint = pos;
+        return &entries_[pos].second;
+    }
+
+    size_t Closure::count(const std::string& name) const {
+        return FindPosition(name) == NO_POSITION ? 0 : 1;
+    }
+
+    ObjectHolder& Closure::at(const std::string& name) {
+        size_t pos = FindPosition(name);
+        if (pos == NO_POSITION) {
+            throw std::out_of_range("Name "s + name + " is not defined"s);
+        }
+        return entries_[pos].second;
+    }
+
+    const ObjectHolder& Closure::at(const std::string& name) const {
+        return const_cast<Closure*>(this)->at(name);
+    }
+
+    ObjectHolder& Closure::operator[](const std::string& name) {
+        return emplace(name, ObjectHolder::None()).first->second;
+    }
+
+    std::pair<Closure::iterator, bool> Closure::emplace(const std::string& name, ObjectHolder value) {
+        size_t pos = FindPosition(name);
+        if (pos != NO_POSITION) {
+            return { entries_.begin() + pos, false };
+        }
+        entries_.emplace_back(name, std::move(value));
+        if (!index_.empty() && entries_.size() * 2 <= index_.size()) {
+            AddToIndex(entries_.size() - 1);
+        }
+        else if (entries_.size() >= INDEX_THRESHOLD) {
+            RebuildIndex();
+        }
+        return { entries_.end() - 1, true };
+    }
+
+    size_t Closure::erase(const std::string& name) {
+        size_t pos = FindPosition(name);
+        if (pos == NO_POSITION) {
+            return 0;
+        }
+        entries_.erase(entries_.begin() + pos);
+        if (!index_.empty()) {
+            RebuildIndex();
+        }
+        return 1;
+    }
+
+    void Closure::clear() {
+        entries_.clear();
+        index_.clear();
+    }
+
+    CallStack::Frame::Frame(CallStack& stack)
+        : stack_(stack)
+        , closure_(stack.Push())
+    {
+    }
+
+    CallStack::Frame::~Frame() {
+        stack_.Pop();
+    }
+
+    Closure& CallStack::Frame::operator*() const {
+        return closure_;
+    }
+
+    Closure* CallStack::Frame::operator->() const {
+        return &closure_;
+    }
+
+    size_t CallStack::GetDepth() const {
+        return depth_;
+    }
+
+    void CallStack::SetMaxDepth(size_t max_depth) {
+        max_depth_ = max_depth;
+    }
+
+    size_t CallStack::GetMaxDepth() const {
+        return max_depth_;
+    }
+
+    Closure& CallStack::Push() {
+        if (depth_ >= max_depth_) {
+            throw std::runtime_error("Maximum recursion depth exceeded"s);
+        }
+        CheckNativeStack();
+        if (depth_ == frames_.size()) {
+            frames_.emplace_back();
+        }
+        return frames_[depth_++];
+    }
+
+    void CallStack::Pop() {
+        frames_[--depth_].clear();
+    }
+
+    //   ,   ,       
+    bool IsNativeStackExhausted() {
+        if (native_stack_limit == 0) {
+            native_stack_limit = ComputeNativeStackLimit();
+        }
+        char probe = 0;
+        return reinterpret_cast<uintptr_t>(&probe) < native_stack_limit;
+    }
+
+    void CheckNativeStack() {
+        if (IsNativeStackExhausted()) {
+            throw std::runtime_error("Maximum recursion depth exceeded: native stack exhausted"s);
+        }
+    }
+
+    void RunWithStackSize(size_t stack_size, const std::function<void()>& task) {
+        struct Task {
+            const std::function<void()>& task;
+            std::exception_ptr error;
+        } state{ task, nullptr };
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        int rc = pthread_attr_setstacksize(&attr, stack_size);
+        pthread_t thread;
+        if (rc == 0) {
+            rc = pthread_create(&thread, &attr, [](void* arg) -> void* {
+                auto& state = *static_cast<Task*>(arg);
+                try {
+                    state.task();
+                }
+                catch (...) {
+                    state.error = std::current_exception();
+                }
+                return nullptr;
+            }, &state);
+        }
+        pthread_attr_destroy(&attr);
+        if (rc != 0) {
+            throw std::runtime_error("Cannot start a thread with a stack of "s + to_string(stack_size) + " bytes"s);
+        }
+        pthread_join(thread, nullptr);
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+    }
+
     bool IsTrue(const ObjectHolder& object) {
-        if (!object) {
+        switch (object.GetTypeTag()) {
+        case TypeTag::NUMBER:
+            return static_cast<const Number&>(*object).GetValue() != 0;
+        case TypeTag::BIG_NUMBER:
+            return !static_cast<const BigNumber&>(*object).GetValue().IsZero();
+        case TypeTag::STRING:
+            return !static_cast<const String&>(*object).GetValue().empty();
+        case TypeTag::BOOL:
+            return static_cast<const Bool&>(*object).GetValue();
+        case TypeTag::LIST:
+            return static_cast<const List&>(*object).Size() != 0;
+        case TypeTag::DICT:
+            return static_cast<const Dict&>(*object).Size() != 0;
+        case TypeTag::RANGE:
+            return static_cast<const Range&>(*object).Size() != 0;
+        default:
             return false;
         }
-        DummyContext context;
+    }
 
-        Number* obj_num = object.TryAs<Number>();
-        String* obj_str = object.TryAs<String>();
-        Bool* obj_boolean = object.TryAs<Bool>();
-        if (obj_num) {
-            return obj_num->GetValue() != 0;
+    bool IsTrue(const ObjectHolder& object, Context& context) {
+        if (object.GetTypeTag() != TypeTag::INSTANCE) {
+            return IsTrue(object);
         }
-        else if (obj_str) {
-            return obj_str->GetValue() != ""s;
-        }
-        else if (obj_boolean) {
-            return obj_boolean->GetValue() != false;
+        auto& instance = static_cast<ClassInstance&>(*object);
+        const Method* method = dunder_caches.boolean.Lookup(instance.GetClass(), BOOL_METHOD);
+        if (!method || !method->formal_params.empty()) {
+            method = dunder_caches.len.Lookup(instance.GetClass(), LEN_METHOD);
+            if (!method || !method->formal_params.empty()) {
+                return false;
+            }
         }
+        CallStack::Frame frame(context.GetCallStack());
+        frame->emplace(SELF, object);
+        return IsTrue(instance.CallInFrame(*method, *frame, context), context);
+    }
 
-        return false;
+    TypeTag ClassInstance::GetTypeTag() const {
+        return TypeTag::INSTANCE;
     }
 
     void ClassInstance::Print(std::ostream& os, Context& context) {
-        if (HasMethod(STR_METHOD, 0)) {
-            ObjectHolder str_result = Call(STR_METHOD, {}, context);
+        const Method* str_method = dunder_caches.str.Lookup(cls_, STR_METHOD);
+        if (str_method && str_method->formal_params.empty()) {
+            ObjectHolder str_result = CallStr(*str_method, context);
             str_result->Print(os, context);
         }
         else {
@@ -82,6 +527,24 @@ namespace runtime {
         }
     }
 
+    void ClassInstance::AppendTo(std::string& out, Context& context) {
+        const Method* str_method = dunder_caches.str.Lookup(cls_, STR_METHOD);
+        if (str_method && str_method->formal_params.empty()) {
+            ObjectHolder str_result = CallStr(*str_method, context);
+            str_result->AppendTo(out, context);
+        }
+        else {
+            Object::AppendTo(out, context);
+        }
+    }
+
+    ObjectHolder ClassInstance::CallStr(const Method& method, Context& context) {
+        //  __str__  :       self
+        CallStack::Frame frame(context.GetCallStack());
+        frame->emplace(SELF, GetHolder());
+        return CallInFrame(method, *frame, context);
+    }
+
     bool ClassInstance::HasMethod(const std::string& method, size_t argument_count) const {
         const Method* needed = cls_.GetMethod(method);
         if (needed) {
@@ -92,19 +555,170 @@ namespace runtime {
         return false;
     }
 
+    Shape::Shape(const Shape& parent, const std::string& name)
+        : names_(parent.names_)
+    {
+        names_.push_back(name);
+        if (names_.size() > LINEAR_LOOKUP_LIMIT) {
+            for (size_t slot = 0; slot < names_.size(); ++slot) {
+                index_.emplace(names_[slot], slot);
+            }
+        }
+    }
+
+    size_t Shape::FindSlot(const std::string& name) const {
+        if (names_.size() > LINEAR_LOOKUP_LIMIT) {
+            auto it = index_.find(name);
+            return it == index_.end() ? NO_SLOT : it->second;
+        }
+        for (size_t slot = 0; slot < names_.size(); ++slot) {
+            if (names_[slot] == name) {
+                return slot;
+            }
+        }
+        return NO_SLOT;
+    }
+
+    Shape::~Shape() {
+        Shape* transition = transitions_.load(memory_order_relaxed);
+        while (transition) {
+            Shape* next = transition->next_transition_;
+            delete transition;
+            transition = next;
+        }
+    }
+
+    const Shape* Shape::AddField(const std::string& name) const {
+        Shape* head = transitions_.load(memory_order_acquire);
+        for (Shape* transition = head; transition; transition = transition->next_transition_) {
+            if (transition->names_.back() == name) {
+                return transition;
+            }
+        }
+        std::unique_ptr<Shape> created(new Shape(*this, name));
+        created->next_transition_ = head;
+        while (!transitions_.compare_exchange_weak(created->next_transition_, created.get(),
+            memory_order_release, memory_order_acquire)) {
+            //     :      ,  
+            for (Shape* transition = created->next_transition_; transition != head; transition = transition->next_transition_) {
+                if (transition->names_.back() == name) {
+                    return transition;
+                }
+            }
+            head = created->next_transition_;
+        }
+        return created.release();
+    }
+
+    size_t Shape::FieldCount() const {
+        return names_.size();
+    }
+
+    const std::string& Shape::FieldName(size_t slot) const {
+        return names_.at(slot);
+    }
+
+    ObjectHolder* ClassInstance::FindField(const std::string& name) {
+        if (dictionary_) {
+            auto it = dictionary_->find(name);
+            return it == dictionary_->end() ? nullptr : &it->second;
+        }
+        size_t slot = shape_->FindSlot(name);
+        return slot == Shape::NO_SLOT ? nullptr : &slots_[slot];
+    }
+
+    const ObjectHolder* ClassInstance::FindField(const std::string& name) const {
+        return const_cast<ClassInstance*>(this)->FindField(name);
+    }
+
+    ObjectHolder& ClassInstance::SetField(const std::string& name, ObjectHolder value) {
+        if (ObjectHolder* field = FindField(name)) {
+            *field = std::move(value);
+            return *field;
+        }
+        if (dictionary_) {
+            return (*dictionary_)[name] = std::move(value);
+        }
+        shape_ = shape_->AddField(name);
+        slots_.push_back(std::move(value));
+        return slots_.back();
+    }
+
+    const Shape* ClassInstance::GetShape() const {
+        return dictionary_ ? nullptr : shape_;
+    }
+
+    ObjectHolder& ClassInstance::GetSlot(size_t slot) {
+        return slots_[slot];
+    }
+
+    const Class& ClassInstance::GetClass() const {
+        return cls_;
+    }
+
+    Closure& ClassInstance::ToDictionaryMode() const {
+        if (!dictionary_) {
+            auto dictionary = std::make_unique<Closure>();
+            for (size_t slot = 0; slot < slots_.size(); ++slot) {
+                dictionary->emplace(shape_->FieldName(slot), std::move(slots_[slot]));
+            }
+            slots_.clear();
+            slots_.shrink_to_fit();
+            dictionary_ = std::move(dictionary);
+        }
+        return *dictionary_;
+    }
+
+    void ClassInstance::Traverse(const std::function<void(const ObjectHolder&)>& visitor) const {
+        if (dictionary_) {
+            for (const auto& [name, value] : *dictionary_) {
+                visitor(value);
+            }
+            return;
+        }
+        for (const ObjectHolder& value : slots_) {
+            visitor(value);
+        }
+    }
+
+    void ClassInstance::ClearReferences() {
+        slots_.clear();
+        shape_ = cls_.GetRootShape();
+        if (dictionary_) {
+            dictionary_->clear();
+        }
+    }
+
     Closure& ClassInstance::Fields() {
-        return closure_;
+        return ToDictionaryMode();
     }
 
     const Closure& ClassInstance::Fields() const {
-        return closure_;
+        return ToDictionaryMode();
     }
 
     ClassInstance::ClassInstance(const Class& cls)
         : cls_(cls)
-        , closure_({})
+        , shape_(cls.GetRootShape())
     {
-        closure_["self"s] = ObjectHolder::Share(*this);
+        if (const NativeFactory factory = cls.GetNativeFactory()) {
+            native_ = factory();
+        }
+    }
+
+    ClassInstance::~ClassInstance() {
+        for (ObjectHolder& slot : slots_) {
+            Release(slot);
+        }
+        if (dictionary_) {
+            for (auto& [name, value] : *dictionary_) {
+                Release(value);
+            }
+        }
+    }
+
+    NativeData* ClassInstance::GetNativeData() const {
+        return native_.get();
     }
 
     ObjectHolder ClassInstance::Call(const std::string& method,
@@ -114,24 +728,74 @@ namespace runtime {
         if (!HasMethod(method, actual_args.size())) {
             throw std::runtime_error("Not implemented"s);
         }
+        return Call(*cls_.GetMethod(method), actual_args, context);
+    }
 
-        Closure method_closure{};
-        method_closure["self"s] = ObjectHolder::Share(*this);
-        const Method* m = cls_.GetMethod(method);
+    ObjectHolder ClassInstance::Call(const Method& method,
+        const std::vector<ObjectHolder>& actual_args,
+        Context& context)
+    {
+        if (method.formal_params.size() != actual_args.size()) {
+            throw std::runtime_error("Wrong number of arguments for method "s + method.name);
+        }
+
+        CallStack::Frame frame(context.GetCallStack());
+        frame->emplace(SELF, GetHolder());
         size_t idx = 0;
-        for (const string& arg_name : m->formal_params) {
-            method_closure[arg_name] = actual_args[idx++];
+        for (const string& arg_name : method.formal_params) {
+            (*frame)[arg_name] = actual_args[idx++];
         }
 
-        ObjectHolder result = m->body->Execute(method_closure, context);
-        return result;
+        return CallInFrame(method, *frame, context);
+    }
+
+    ObjectHolder ClassInstance::CallInFrame(const Method& method, Closure& frame, Context& context) {
+        const Method* current = &method;
+        while (true) {
+            ObjectHolder result = current->body->Execute(frame, context);
+            if (context.GetCompletion() != Completion::TAIL_CALL) {
+                return result;
+            }
+
+            TailCall tail_call = context.TakeTailCall();
+            current = tail_call.method;
+            vector<ObjectHolder>& args = context.GetTailCallArgs();
+            const size_t base = args.size() - current->formal_params.size();
+            frame.clear();
+            frame.emplace(SELF, std::move(tail_call.self));
+            for (size_t i = 0; i < current->formal_params.size(); ++i) {
+                frame.emplace(current->formal_params[i], std::move(args[base + i]));
+            }
+            args.resize(base);
+        }
     }
 
     Class::Class(std::string name, std::vector<Method> methods, const Class* parent)
         : name_(move(name))
         , methods_(move(methods))
         , parent_ptr_(parent)
+        , root_shape_(std::make_unique<Shape>())
+        , id_(next_class_id.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    uint64_t Class::GetId() const {
+        return id_;
+    }
+
+    Class::Class(std::string name, std::vector<Method> methods, const Class* parent, NativeFactory native_factory)
+        : Class(move(name), move(methods), parent)
     {
+        native_factory_ = native_factory;
+    }
+
+    NativeFactory Class::GetNativeFactory() const {
+        for (const Class* cls = this; cls; cls = cls->parent_ptr_) {
+            if (cls->native_factory_) {
+                return cls->native_factory_;
+            }
+        }
+        return nullptr;
     }
 
     optional<vector<Method>::const_iterator> Class::FindMethod(const string& name) const {
@@ -149,6 +813,10 @@ namespace runtime {
         return parent_ptr_;
     }
 
+    const Shape* Class::GetRootShape() const {
+        return root_shape_.get();
+    }
+
     const Method* Class::GetMethod(const std::string& name) const {
         auto needed = FindMethod(name);
         if (!needed.has_value()) {
@@ -181,84 +849,303 @@ namespace runtime {
         os << (GetValue() ? "True"sv : "False"sv);
     }
 
-    template <typename Comparator>
-    bool Compare(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context, Comparator cmp) {
-        Number* lhs_num = lhs.TryAs<Number>();
-        String* lhs_str = lhs.TryAs<String>();
-        Bool* lhs_boolean = lhs.TryAs<Bool>();
-        ClassInstance* lhs_class_inst = lhs.TryAs<ClassInstance>();
-        if (lhs_num) {
-            Number* rhs_num = rhs.TryAs<Number>();
-            if (!rhs_num) {
-                throw std::runtime_error("Cannot compare objects for equality"s);
+    void Bool::AppendTo(std::string& out, [[maybe_unused]] Context& context) {
+        out.append(GetValue() ? "True"sv : "False"sv);
+    }
+
+    void Object::AppendTo(std::string& out, Context& context) {
+        StringAppendBuf buffer(out);
+        std::ostream os(&buffer);
+        Print(os, context);
+    }
+
+    ObjectHolder MakeBool(bool value) {
+        return ObjectHolder::Share(value ? true_value : false_value);
+    }
+
+    namespace {
+        enum class Comparison {
+            EQUAL,
+            NOT_EQUAL,
+            LESS,
+            GREATER,
+            LESS_OR_EQUAL,
+            GREATER_OR_EQUAL
+        };
+
+        using ComparisonHandler = bool (*)(const ObjectHolder& lhs, const ObjectHolder& rhs,
+                                           Comparison comparison, Context& context);
+
+        [[noreturn]] void ThrowUncomparable() {
+            throw std::runtime_error("Cannot compare objects for equality"s);
+        }
+
+        template <typename T>
+        bool ApplyComparison(const T& lhs, const T& rhs, Comparison comparison) {
+            switch (comparison) {
+            case Comparison::EQUAL:
+                return lhs == rhs;
+            case Comparison::NOT_EQUAL:
+                return !(lhs == rhs);
+            case Comparison::LESS:
+                return lhs < rhs;
+            case Comparison::GREATER:
+                return rhs < lhs;
+            case Comparison::LESS_OR_EQUAL:
+                return !(rhs < lhs);
+            case Comparison::GREATER_OR_EQUAL:
+                return !(lhs < rhs);
             }
-            return cmp(lhs_num->GetValue(), rhs_num->GetValue());
+            ThrowUncomparable();
+        }
+
+        //   -  
+        template <typename T>
+        bool CompareValues(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context&) {
+            return ApplyComparison(static_cast<const ValueObject<T>&>(*lhs).GetValue(),
+                                   static_cast<const ValueObject<T>&>(*rhs).GetValue(), comparison);
+        }
+
+        //   ,      - BigNumber
+        bool CompareIntegers(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context&) {
+            return ApplyComparison(ToBigInt(lhs), ToBigInt(rhs), comparison);
+        }
+
+        bool CompareNones(const ObjectHolder&, const ObjectHolder&, Comparison comparison, Context&) {
+            if (comparison == Comparison::EQUAL) {
+                return true;
+            }
+            if (comparison == Comparison::NOT_EQUAL) {
+                return false;
+            }
+            ThrowUncomparable();
+        }
+
+        bool CompareUncomparable(const ObjectHolder&, const ObjectHolder&, Comparison, Context&) {
+            ThrowUncomparable();
+        }
+
+        //    name    nullptr,    
+        const Method* FindComparisonMethod(InlineCache& cache, const ClassInstance& instance, const std::string& name) {
+            const Method* method = cache.Lookup(instance.GetClass(), name);
+            return method && method->formal_params.size() == 1 ? method : nullptr;
+        }
+
+        //       ,  rhs  
+        bool CallComparisonMethod(const Method& method, const ObjectHolder& lhs, const ObjectHolder& rhs,
+                                  Context& context) {
+            CallStack::Frame frame(context.GetCallStack());
+            frame->emplace(SELF, lhs);
+            frame->emplace(method.formal_params.front(), rhs);
+            return IsTrue(static_cast<ClassInstance&>(*lhs).CallInFrame(method, *frame, context), context);
         }
-        else if (lhs_str) {
-            String* rhs_str = rhs.TryAs<String>();
-            if (!rhs_str) {
-                throw std::runtime_error("Cannot compare objects for equality"s);
+
+        bool CompareInstances(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison,
+                              Context& context) {
+            const auto& instance = static_cast<const ClassInstance&>(*lhs);
+            auto call_required = [&](InlineCache& cache, const std::string& name) {
+                const Method* method = FindComparisonMethod(cache, instance, name);
+                if (!method) {
+                    ThrowUncomparable();
+                }
+                return CallComparisonMethod(*method, lhs, rhs, context);
+            };
+
+            switch (comparison) {
+            case Comparison::EQUAL:
+                return call_required(dunder_caches.eq, EQ_METHOD);
+            case Comparison::LESS:
+                return call_required(dunder_caches.lt, LT_METHOD);
+            case Comparison::NOT_EQUAL:
+                if (const Method* method = FindComparisonMethod(dunder_caches.ne, instance, NE_METHOD)) {
+                    return CallComparisonMethod(*method, lhs, rhs, context);
+                }
+                return !CompareInstances(lhs, rhs, Comparison::EQUAL, context);
+            case Comparison::GREATER:
+                if (const Method* method = FindComparisonMethod(dunder_caches.gt, instance, GT_METHOD)) {
+                    return CallComparisonMethod(*method, lhs, rhs, context);
+                }
+                return !CompareInstances(lhs, rhs, Comparison::LESS, context)
+                    && !CompareInstances(lhs, rhs, Comparison::EQUAL, context);
+            case Comparison::LESS_OR_EQUAL:
+                if (const Method* method = FindComparisonMethod(dunder_caches.le, instance, LE_METHOD)) {
+                    return CallComparisonMethod(*method, lhs, rhs, context);
+                }
+                return !CompareInstances(lhs, rhs, Comparison::GREATER, context);
+            case Comparison::GREATER_OR_EQUAL:
+                if (const Method* method = FindComparisonMethod(dunder_caches.ge, instance, GE_METHOD)) {
+                    return CallComparisonMethod(*method, lhs, rhs, context);
+                }
+                return !CompareInstances(lhs, rhs, Comparison::LESS, context);
             }
-            return cmp(lhs_str->GetValue(), rhs_str->GetValue());
+            ThrowUncomparable();
         }
-        else if (lhs_boolean) {
-            Bool* rhs_boolean = rhs.TryAs<Bool>();
-            if (!rhs_boolean) {
-                throw std::runtime_error("Cannot compare objects for equality"s);
+
+        bool Compare(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context& context);
+
+        //   ,   
+        bool CompareLists(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context& context) {
+            CheckNativeStack();
+            const auto& lhs_items = static_cast<const List&>(*lhs).GetItems();
+            const auto& rhs_items = static_cast<const List&>(*rhs).GetItems();
+            if ((comparison == Comparison::EQUAL || comparison == Comparison::NOT_EQUAL)
+                && lhs_items.size() != rhs_items.size()) {
+                return comparison == Comparison::NOT_EQUAL;
             }
-            return cmp(lhs_boolean->GetValue(), rhs_boolean->GetValue());
+            // __eq__     ,      ,
+            //     
+            for (size_t i = 0; i < lhs_items.size() && i < rhs_items.size(); ++i) {
+                const ObjectHolder lhs_item = lhs_items[i];
+                const ObjectHolder rhs_item = rhs_items[i];
+                if (!Compare(lhs_item, rhs_item, Comparison::EQUAL, context)) {
+                    return comparison != Comparison::EQUAL
+                        && (comparison == Comparison::NOT_EQUAL
+                            || Compare(lhs_item, rhs_item, comparison, context));
+                }
+            }
+            return ApplyComparison(lhs_items.size(), rhs_items.size(), comparison);
         }
-        else if (lhs_class_inst) {
-            if (!lhs_class_inst->HasMethod((cmp(0, 0) ? EQ_METHOD : LT_METHOD), 1)) {
-                throw std::runtime_error("Cannot compare objects for equality"s);
+
+        //  ,       .   
+        bool CompareDicts(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context& context) {
+            CheckNativeStack();
+            if (comparison != Comparison::EQUAL && comparison != Comparison::NOT_EQUAL) {
+                ThrowUncomparable();
+            }
+            const auto& lhs_dict = static_cast<const Dict&>(*lhs);
+            auto& rhs_dict = static_cast<Dict&>(*rhs);
+            if (lhs_dict.Size() != rhs_dict.Size()) {
+                return comparison == Comparison::NOT_EQUAL;
+            }
+            //      ,    
+            std::vector<std::pair<ObjectHolder, ObjectHolder>> pairs;
+            pairs.reserve(lhs_dict.Size());
+            lhs_dict.ForEach([&pairs](const ObjectHolder& key, const ObjectHolder& value) {
+                pairs.emplace_back(key, value);
+            });
+            bool equal = true;
+            for (const auto& [key, value] : pairs) {
+                const ObjectHolder* found = rhs_dict.Find(key, context);
+                if (!found) {
+                    equal = false;
+                    break;
+                }
+                const ObjectHolder other = *found;
+                if (!Compare(value, other, Comparison::EQUAL, context)) {
+                    equal = false;
+                    break;
+                }
             }
+            return equal == (comparison == Comparison::EQUAL);
+        }
+
+        constexpr size_t TYPE_COUNT = static_cast<size_t>(TypeTag::COUNT);
+        using ComparisonTable = std::array<std::array<ComparisonHandler, TYPE_COUNT>, TYPE_COUNT>;
 
-            ClassInstance* rhs_class_inst = rhs.TryAs<ClassInstance>();
-            if (!rhs_class_inst) {
-                throw std::runtime_error("Cannot compare objects for equality"s);
+        //   ,      
+        ComparisonTable MakeComparisonTable() {
+            ComparisonTable table;
+            for (auto& row : table) {
+                row.fill(CompareUncomparable);
             }
+            auto set = [&table](TypeTag lhs, TypeTag rhs, ComparisonHandler handler) {
+                table[static_cast<size_t>(lhs)][static_cast<size_t>(rhs)] = handler;
+            };
+            set(TypeTag::NONE, TypeTag::NONE, CompareNones);
+            set(TypeTag::NUMBER, TypeTag::NUMBER, CompareValues<int64_t>);
+            set(TypeTag::NUMBER, TypeTag::BIG_NUMBER, CompareIntegers);
+            set(TypeTag::BIG_NUMBER, TypeTag::NUMBER, CompareIntegers);
+            set(TypeTag::BIG_NUMBER, TypeTag::BIG_NUMBER, CompareIntegers);
+            set(TypeTag::STRING, TypeTag::STRING, CompareValues<std::string>);
+            set(TypeTag::BOOL, TypeTag::BOOL, CompareValues<bool>);
+            set(TypeTag::INSTANCE, TypeTag::INSTANCE, CompareInstances);
+            set(TypeTag::LIST, TypeTag::LIST, CompareLists);
+            set(TypeTag::DICT, TypeTag::DICT, CompareDicts);
+            return table;
+        }
 
-            DummyContext context;
-            return IsTrue(lhs_class_inst->Call((cmp(0, 0) ? EQ_METHOD : LT_METHOD),
-                         { ObjectHolder::Share(*rhs_class_inst) }, context));
+        const ComparisonTable comparison_table = MakeComparisonTable();
+
+        bool Compare(const ObjectHolder& lhs, const ObjectHolder& rhs, Comparison comparison, Context& context) {
+            const ComparisonHandler handler = comparison_table[static_cast<size_t>(lhs.GetTypeTag())]
+                                                              [static_cast<size_t>(rhs.GetTypeTag())];
+            return handler(lhs, rhs, comparison, context);
         }
-        return false;
-    }
+    }  // namespace
 
-    bool Equal(const ObjectHolder& lhs, const ObjectHolder& rhs, [[maybe_unused]] Context& context) {
-        if (!lhs && !rhs) {
-            return true;
+    namespace {
+        //    ,        -
+        size_t MixHash(uint64_t value) {
+            value ^= value >> 33;
+            value *= 0xff51afd7ed558ccdULL;
+            value ^= value >> 33;
+            value *= 0xc4ceb9fe1a85ec53ULL;
+            value ^= value >> 33;
+            return static_cast<size_t>(value);
         }
-        else if (!lhs || !rhs) {
-            throw std::runtime_error("Cannot compare objects for equality"s);
+
+        size_t HashInteger(const ObjectHolder& object) {
+            if (object.GetTypeTag() == TypeTag::NUMBER) {
+                return MixHash(static_cast<uint64_t>(static_cast<const Number&>(*object).GetValue()));
+            }
+            // BigNumber    int64,       Number
+            return std::hash<std::string>{}(static_cast<const BigNumber&>(*object).GetValue().ToString());
         }
-        return Compare(lhs, rhs, context, std::equal_to<>());
-    }
+    }  // namespace
 
-    bool Less(const ObjectHolder& lhs, const ObjectHolder& rhs, [[maybe_unused]] Context& context) {
-        if (!lhs || !rhs) {
-            throw std::runtime_error("Cannot compare objects for equality"s);
+    size_t Hash(const ObjectHolder& object, Context& context) {
+        switch (object.GetTypeTag()) {
+        case TypeTag::NONE:
+            return MixHash(0x9e3779b97f4a7c15ULL);
+        case TypeTag::NUMBER:
+        case TypeTag::BIG_NUMBER:
+            return HashInteger(object);
+        case TypeTag::STRING:
+            return std::hash<std::string>{}(static_cast<const String&>(*object).GetValue());
+        case TypeTag::BOOL:
+            return MixHash(static_cast<const Bool&>(*object).GetValue() ? 0x2545f4914f6cdd1dULL : 0x27bb2ee687b0b0fdULL);
+        case TypeTag::INSTANCE: {
+            auto& instance = static_cast<ClassInstance&>(*object);
+            const Method* method = dunder_caches.hash.Lookup(instance.GetClass(), HASH_METHOD);
+            if (!method || !method->formal_params.empty()) {
+                break;
+            }
+            CallStack::Frame frame(context.GetCallStack());
+            frame->emplace(SELF, object);
+            const ObjectHolder result = instance.CallInFrame(*method, *frame, context);
+            if (!IsInteger(result)) {
+                throw std::runtime_error("__hash__ must return an integer"s);
+            }
+            return HashInteger(result);
+        }
+        default:
+            break;
         }
-        return Compare(lhs, rhs, context, std::less<>());
+        throw std::runtime_error("Unhashable type"s);
+    }
+
+    bool Equal(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
+        return Compare(lhs, rhs, Comparison::EQUAL, context);
+    }
+
+    bool Less(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
+        return Compare(lhs, rhs, Comparison::LESS, context);
     }
 
     bool NotEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
-        return !Equal(lhs, rhs, context);
+        return Compare(lhs, rhs, Comparison::NOT_EQUAL, context);
     }
 
     bool Greater(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
-        return !Less(lhs, rhs, context) && !Equal(lhs, rhs, context);
-        throw std::runtime_error("Cannot compare objects for equality"s);
+        return Compare(lhs, rhs, Comparison::GREATER, context);
     }
 
     bool LessOrEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
-        return !Greater(lhs, rhs, context);
-        throw std::runtime_error("Cannot compare objects for equality"s);
+        return Compare(lhs, rhs, Comparison::LESS_OR_EQUAL, context);
     }
 
     bool GreaterOrEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
-        return !Less(lhs, rhs, context);
-        throw std::runtime_error("Cannot compare objects for equality"s);
+        return Compare(lhs, rhs, Comparison::GREATER_OR_EQUAL, context);
     }
 
 }  // namespace runtime
\ No newline at end of file
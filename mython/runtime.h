@@ -1,21 +1,41 @@
 #pragma once
 
+#include "output.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <optional>
 
 namespace runtime {
-    //    Mython
-    class Context {
-    public:
-        //      print
-        virtual std::ostream& GetOutputStream() = 0;
-
-    protected:
-        ~Context() = default;
+    class ClassInstance;
+    class Context;
+    class CycleCollector;
+    class GcObject;
+    struct Method;
+
+    //  ,           
+    enum class TypeTag : uint8_t {
+        NONE,
+        NUMBER,
+        BIG_NUMBER,
+        STRING,
+        BOOL,
+        INSTANCE,
+        LIST,
+        DICT,
+        RANGE,
+        OTHER,
+        COUNT
     };
 
     //       Mython
@@ -24,6 +44,13 @@ namespace runtime {
         virtual ~Object() = default;
         //   os     
         virtual void Print(std::ostream& os, Context& context) = 0;
+        //       out.     Print
+        //  ,    out;       iostream
+        virtual void AppendTo(std::string& out, Context& context);
+        //     
+        [[nodiscard]] virtual TypeTag GetTypeTag() const {
+            return TypeTag::OTHER;
+        }
     };
 
     //  -,      Mython-
@@ -40,7 +67,8 @@ namespace runtime {
             return ObjectHolder(std::make_shared<T>(std::forward<T>(object)));
         }
 
-        //  ObjectHolder,    (  )
+        //  ObjectHolder,    (  ).
+        //  ObjectHolder    ,      
         [[nodiscard]] static ObjectHolder Share(Object& object);
         //   ObjectHolder,   None
         [[nodiscard]] static ObjectHolder None();
@@ -60,16 +88,49 @@ namespace runtime {
             return dynamic_cast<T*>(this->Get());
         }
 
+        //      TypeTag::NONE   ObjectHolder
+        [[nodiscard]] TypeTag GetTypeTag() const;
+
         //  true,  ObjectHolder  
         explicit operator bool() const;
 
+        //  true,  ObjectHolder   (  Own,   Share)
+        [[nodiscard]] bool IsOwning() const;
+
+        //  true,  ObjectHolder -   .
+        //       :     
+        [[nodiscard]] bool IsUnique() const;
+
     private:
+        friend class GcObject;
+
         explicit ObjectHolder(std::shared_ptr<Object> data);
         void AssertIsValid() const;
 
         std::shared_ptr<Object> data_;
     };
 
+    //  -,    T
+    template <typename T>
+    struct ValueTypeTag {
+        static constexpr TypeTag VALUE = TypeTag::OTHER;
+    };
+
+    template <>
+    struct ValueTypeTag<int64_t> {
+        static constexpr TypeTag VALUE = TypeTag::NUMBER;
+    };
+
+    template <>
+    struct ValueTypeTag<std::string> {
+        static constexpr TypeTag VALUE = TypeTag::STRING;
+    };
+
+    template <>
+    struct ValueTypeTag<bool> {
+        static constexpr TypeTag VALUE = TypeTag::BOOL;
+    };
+
     // -,    T
     template <typename T>
     class ValueObject : public Object {
@@ -82,21 +143,308 @@ namespace runtime {
             os << value_;
         }
 
+        void AppendTo(std::string& out, Context& context) override {
+            if constexpr (std::is_same_v<T, std::string>) {
+                out.append(value_);
+            }
+            else if constexpr (std::is_same_v<T, int64_t>) {
+                AppendInteger(out, value_);
+            }
+            else {
+                Object::AppendTo(out, context);
+            }
+        }
+
+        [[nodiscard]] TypeTag GetTypeTag() const override {
+            return ValueTypeTag<T>::VALUE;
+        }
+
         [[nodiscard]] const T& GetValue() const {
             return value_;
         }
 
+        //     .   ,  
+        //    ObjectHolder (. ObjectHolder::IsUnique)
+        [[nodiscard]] T& GetMutableValue() {
+            return value_;
+        }
+
     private:
         T value_;
     };
 
-    //  ,      
-    using Closure = std::unordered_map<std::string, ObjectHolder>;
+    /*
+     *    Closure::FindWithHint,    .
+     *       ,   
+     *   .    ,      
+     */
+    class ClosureHint {
+    public:
+        ClosureHint() = default;
+        ClosureHint(const ClosureHint& /*other*/) {
+        }
+        ClosureHint& operator=(const ClosureHint&) = delete;
+
+        [[nodiscard]] size_t Load() const {
+            return position_.load(std::memory_order_relaxed);
+        }
+
+        void Store(size_t position) {
+            position_.store(position, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<size_t> position_{ 0 };
+    };
+
+    /*
+     *  ,      .
+     *      ,    ;
+     *    (,  )  -.
+     * clear()   ,    
+     */
+    class Closure {
+    public:
+        using value_type = std::pair<std::string, ObjectHolder>;
+        using iterator = std::vector<value_type>::iterator;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        Closure() = default;
+        Closure(std::initializer_list<value_type> entries);
+
+        [[nodiscard]] iterator begin();
+        [[nodiscard]] iterator end();
+        [[nodiscard]] const_iterator begin() const;
+        [[nodiscard]] const_iterator end() const;
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] iterator find(const std::string& name);
+        [[nodiscard]] const_iterator find(const std::string& name) const;
+
+        //     name  nullptr   .
+        // hint - ,        :    
+        //  ,   .    hint    
+        [[nodiscard]] ObjectHolder* FindWithHint(const std::string& name, size_t& hint);
+        [[nodiscard]] ObjectHolder* FindWithHint(const std::string& name, ClosureHint& hint);
+        [[nodiscard]] size_t count(const std::string& name) const;
+
+        //   name,  std::out_of_range   
+        ObjectHolder& at(const std::string& name);
+        const ObjectHolder& at(const std::string& name) const;
+
+        //   name,      
+        ObjectHolder& operator[](const std::string& name);
+
+        std::pair<iterator, bool> emplace(const std::string& name, ObjectHolder value);
+        size_t erase(const std::string& name);
+
+        //   ,   
+        void clear();
+
+    private:
+        static constexpr size_t NO_POSITION = static_cast<size_t>(-1);
+        //        -
+        static constexpr size_t INDEX_THRESHOLD = 16;
+
+        [[nodiscard]] size_t FindPosition(const std::string& name) const;
+        void RebuildIndex();
+        void AddToIndex(size_t position);
+
+        std::vector<value_type> entries_;
+        //  :   entries_  ,    
+        std::vector<uint32_t> index_;
+    };
+
+    /*
+     *    .  -  Closure,     self,
+     *    -      (   NativeArgs).
+     *  :         ,
+     *           .
+     *
+     *   :   GetMaxDepth()    
+     *      runtime_error   
+     */
+    class CallStack {
+    public:
+        static constexpr size_t DEFAULT_MAX_DEPTH = 100'000;
+
+        //    .     
+        class Frame {
+        public:
+            explicit Frame(CallStack& stack);
+            ~Frame();
+
+            Frame(const Frame&) = delete;
+            Frame& operator=(const Frame&) = delete;
+
+            Closure& operator*() const;
+            Closure* operator->() const;
+
+        private:
+            CallStack& stack_;
+            Closure& closure_;
+        };
+
+        //    
+        [[nodiscard]] size_t GetDepth() const;
+
+        //      
+        void SetMaxDepth(size_t max_depth);
+        [[nodiscard]] size_t GetMaxDepth() const;
+
+    private:
+        Closure& Push();
+        void Pop();
+
+        std::deque<Closure> frames_;
+        size_t depth_ = 0;
+        size_t max_depth_ = DEFAULT_MAX_DEPTH;
+    };
+
+    /*
+     *  task       stack_size ,   ,
+     *    . ,  task,   .
+     *      ,     
+     */
+    void RunWithStackSize(size_t stack_size, const std::function<void()>& task);
+
+    //  true,       (  
+    //   ,    )
+    [[nodiscard]] bool IsNativeStackExhausted();
+
+    //  runtime_error "Maximum recursion depth exceeded",     
+    // .    ,    :  ,
+    //   ,     
+    void CheckNativeStack();
+
+    //    
+    enum class Completion {
+        //     
+        NORMAL,
+        //   return:     
+        RETURN,
+        //   break:     ,  
+        BREAK,
+        //   continue:     
+        CONTINUE,
+        //  return   :  ,   
+        //    (. Context::SetTailCall)
+        TAIL_CALL,
+    };
+
+    //    method   self.     Context::GetTailCallArgs()
+    struct TailCall {
+        ObjectHolder self;
+        const Method* method = nullptr;
+    };
+
+    //   ,   (. ast::ValueStatement).
+    // serial -   ,     value
+    struct ConstantSlot {
+        uint64_t serial = 0;
+        ObjectHolder value;
+    };
+
+    //    Mython
+    class Context {
+    public:
+        //      print
+        virtual OutputSink& GetOutput() = 0;
+
+        //  ,    GetOutput()
+        std::ostream& GetOutputStream() {
+            return GetOutput().GetStream();
+        }
+
+        //     
+        CallStack& GetCallStack() {
+            return call_stack_;
+        }
+
+        //      
+        [[nodiscard]] Completion GetCompletion() const {
+            return completion_;
+        }
+
+        // ,    return   value
+        void SetReturn(ObjectHolder value) {
+            completion_ = Completion::RETURN;
+            return_value_ = std::move(value);
+        }
+
+        //    ,    (break, continue),
+        //     (Completion::NORMAL)
+        void SetCompletion(Completion completion) {
+            completion_ = completion;
+        }
+
+        //   ,   return   
+        void ResetCompletion() {
+            completion_ = Completion::NORMAL;
+            return_value_ = {};
+            tail_call_ = {};
+        }
+
+        //  ,  SetReturn,    
+        ObjectHolder TakeReturnValue() {
+            completion_ = Completion::NORMAL;
+            return std::move(return_value_);
+        }
+
+        //   index   ,    .
+        //          ,
+        //     ConstantSlot::serial
+        ConstantSlot& GetConstantSlot(size_t index) {
+            if (index >= constants_.size()) {
+                constants_.resize(index + 1);
+            }
+            return constants_[index];
+        }
+
+        //     .     
+        std::vector<ObjectHolder>& GetTailCallArgs() {
+            return tail_call_args_;
+        }
+
+        // ,   return    method  self.
+        //        GetTailCallArgs()
+        void SetTailCall(ObjectHolder self, const Method& method) {
+            completion_ = Completion::TAIL_CALL;
+            tail_call_ = { std::move(self), &method };
+        }
+
+        //   ,  SetTailCall,    
+        TailCall TakeTailCall() {
+            completion_ = Completion::NORMAL;
+            return std::move(tail_call_);
+        }
+
+    protected:
+        ~Context() = default;
+
+    private:
+        CallStack call_stack_;
+        Completion completion_ = Completion::NORMAL;
+        ObjectHolder return_value_;
+        TailCall tail_call_;
+        std::vector<ObjectHolder> tail_call_args_;
+        std::vector<ConstantSlot> constants_;
+    };
 
     // ,    object ,   True
     //     , True     true.    - false.
+    //   
     bool IsTrue(const ObjectHolder& object);
 
+    /*
+     *  ,  IsTrue(object),       __bool__ 
+     *   bool   ,    __bool__ -  
+     * __len__,   .     context
+     */
+    bool IsTrue(const ObjectHolder& object, Context& context);
+
     //       Mython
     class Executable {
     public:
@@ -109,7 +457,7 @@ namespace runtime {
     //  
     using String = ValueObject<std::string>;
     //  
-    using Number = ValueObject<int>;
+    using Number = ValueObject<int64_t>;
 
     //  
     class Bool : public ValueObject<bool> {
@@ -117,8 +465,12 @@ namespace runtime {
         using ValueObject<bool>::ValueObject;
 
         void Print(std::ostream& os, Context& context) override;
+        void AppendTo(std::string& out, Context& context) override;
     };
 
+    //  ObjectHolder,     True  False.   
+    ObjectHolder MakeBool(bool value);
+
     //  
     struct Method {
         //  
@@ -129,6 +481,58 @@ namespace runtime {
         std::unique_ptr<Executable> body;
     };
 
+    /*
+     *   () :     .
+     *   ,        ,   ,
+     *           .
+     *          ,   
+     */
+    class Shape {
+    public:
+        static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+        //   () 
+        Shape() = default;
+
+        Shape(const Shape&) = delete;
+        Shape& operator=(const Shape&) = delete;
+        ~Shape();
+
+        //     name  NO_SLOT,      
+        [[nodiscard]] size_t FindSlot(const std::string& name) const;
+
+        //  ,      name.
+        //         
+        [[nodiscard]] const Shape* AddField(const std::string& name) const;
+
+        //     
+        [[nodiscard]] size_t FieldCount() const;
+
+        //   ,    slot
+        [[nodiscard]] const std::string& FieldName(size_t slot) const;
+
+    private:
+        //        ,   
+        static constexpr size_t LINEAR_LOOKUP_LIMIT = 8;
+
+        Shape(const Shape& parent, const std::string& name);
+
+        std::vector<std::string> names_;
+        std::unordered_map<std::string, size_t> index_;
+        //    ,      (  ).
+        //        ,      
+        mutable std::atomic<Shape*> transitions_{ nullptr };
+        Shape* next_transition_ = nullptr;
+    };
+
+    //  C++-,      (. native.h)
+    struct NativeData {
+        virtual ~NativeData() = default;
+    };
+
+    //   C++-     
+    using NativeFactory = std::unique_ptr<NativeData> (*)();
+
     // 
     class Class : public Object {
     public:
@@ -136,6 +540,13 @@ namespace runtime {
         //  parent  nullptr,    
         explicit Class(std::string name, std::vector<Method> methods, const Class* parent);
 
+        //   :    (    -)
+        //  C++-,  native_factory
+        Class(std::string name, std::vector<Method> methods, const Class* parent, NativeFactory native_factory);
+
+        //   C++-        nullptr
+        [[nodiscard]] NativeFactory GetNativeFactory() const;
+
         //     name  nullptr,      
         [[nodiscard]] const Method* GetMethod(const std::string& name) const;
 
@@ -147,24 +558,208 @@ namespace runtime {
 
         const Class* GetParent() const;
 
+        //    .   
+        [[nodiscard]] uint64_t GetId() const;
+
+        //     
+        [[nodiscard]] const Shape* GetRootShape() const;
+
     private:
         std::string name_;
         std::vector<Method> methods_;
         const Class* parent_ptr_;
+        std::unique_ptr<Shape> root_shape_;
+        NativeFactory native_factory_ = nullptr;
+        uint64_t id_;
 
         std::optional<std::vector<Method>::const_iterator> FindMethod(const std::string& name) const;
     };
 
+    /*
+     *      InlineCache  FieldCache,     
+     *   .       :   
+     *      ,  ,   ,  
+     *     .     
+     */
+    class CacheCountingScope {
+    public:
+        CacheCountingScope();
+        ~CacheCountingScope();
+
+        CacheCountingScope(const CacheCountingScope&) = delete;
+        CacheCountingScope& operator=(const CacheCountingScope&) = delete;
+    };
+
+    /*
+     * -   : ,       .
+     *      ,  ,   
+     * ( MAX_ENTRIES ),       ,
+     *         .
+     *
+     * ,    ,     .  
+     *       ,       
+     *     .       
+     * CacheCountingScope.        
+     *       .   
+     */
+    class InlineCache {
+    public:
+        enum class State {
+            UNINITIALIZED,
+            MONOMORPHIC,
+            POLYMORPHIC,
+            MEGAMORPHIC,
+        };
+
+        static constexpr size_t MAX_ENTRIES = 4;
+
+        InlineCache() = default;
+        InlineCache(const InlineCache& /*other*/) {
+        }
+        InlineCache& operator=(const InlineCache&) = delete;
+
+        //   name  cls ( nullptr,   ),  
+        const Method* Lookup(const Class& cls, const std::string& name);
+
+        [[nodiscard]] State GetState() const;
+        //  ,    (. CacheCountingScope)
+        [[nodiscard]] size_t GetHits() const;
+        //  ,     ,  
+        //    (. CacheCountingScope)
+        [[nodiscard]] size_t GetMisses() const;
+
+    private:
+        //    ,    :    
+        //     ,     ,    .
+        //   ,     
+        struct Entry {
+            std::atomic<uint64_t> class_id{ 0 };
+            std::atomic<const Method*> method{ nullptr };
+        };
+
+        Entry entries_[MAX_ENTRIES];
+        //   .   MAX_ENTRIES   
+        std::atomic<size_t> size_{ 0 };
+        std::atomic<size_t> hits_{ 0 };
+        std::atomic<size_t> misses_{ 0 };
+    };
+
+    // -    dunder-
+    struct DunderCaches {
+        InlineCache str;
+        InlineCache boolean;
+        InlineCache len;
+        InlineCache eq;
+        InlineCache ne;
+        InlineCache lt;
+        InlineCache gt;
+        InlineCache le;
+        InlineCache ge;
+        InlineCache hash;
+    };
+
+    //   dunder-,   runtime (print/str, )
+    const DunderCaches& GetDunderCaches();
+
+    /*
+     * -      :       .
+     *       ,        .
+     *      :  ,   ,
+     *             .
+     *                .
+     *   InlineCache,    MAX_ENTRIES   ,    ,
+     *         
+     *   CacheCountingScope.   
+     */
+    class FieldCache {
+    public:
+        static constexpr size_t MAX_ENTRIES = 4;
+
+        FieldCache() = default;
+        FieldCache(const FieldCache& /*other*/) {
+        }
+        FieldCache& operator=(const FieldCache&) = delete;
+
+        //      name  instance  nullptr,   
+        [[nodiscard]] ObjectHolder* Find(ClassInstance& instance, const std::string& name);
+
+        //  ,    (. CacheCountingScope)
+        [[nodiscard]] size_t GetHits() const;
+        //  ,     ,    
+        //        (. CacheCountingScope)
+        [[nodiscard]] size_t GetMisses() const;
+
+    private:
+        struct Entry {
+            std::atomic<uint64_t> class_id{ 0 };
+            std::atomic<const Shape*> shape{ nullptr };
+            std::atomic<size_t> slot{ 0 };
+        };
+
+        Entry entries_[MAX_ENTRIES];
+        std::atomic<size_t> size_{ 0 };
+        std::atomic<size_t> hits_{ 0 };
+        std::atomic<size_t> misses_{ 0 };
+    };
+
+    /*
+     * ,           .
+     *     CycleCollector  ,  
+     *    ,    
+     */
+    class GcObject : public Object, public std::enable_shared_from_this<GcObject> {
+    public:
+        GcObject();
+        GcObject(const GcObject& other);
+        GcObject(GcObject&& other) noexcept;
+        GcObject& operator=(const GcObject&) = delete;
+        GcObject& operator=(GcObject&&) = delete;
+        ~GcObject() override;
+
+        //  visitor   ,   
+        virtual void Traverse(const std::function<void(const ObjectHolder&)>& visitor) const = 0;
+
+        //      .     
+        virtual void ClearReferences() = 0;
+
+    protected:
+        //   ObjectHolder,     ObjectHolder::Own,
+        //     
+        [[nodiscard]] ObjectHolder GetHolder();
+
+        //   holder.    ,    
+        //     ,      Release:
+        //      (,   l = [l])   .
+        //        
+        static void Release(ObjectHolder& holder) noexcept;
+
+    private:
+        friend class CycleCollector;
+
+        CycleCollector* collector_ = nullptr;
+        GcObject* prev_ = nullptr;
+        GcObject* next_ = nullptr;
+        size_t gc_refs_ = 0;
+        uint8_t generation_ = 0;
+        bool collecting_ = false;
+    };
+
     //  
-    class ClassInstance : public Object {
+    class ClassInstance : public GcObject {
     public:
         explicit ClassInstance(const Class& cls);
+        ClassInstance(ClassInstance&&) = default;
+        ~ClassInstance() override;
 
         /*
          *      __str__,   os ,   .
          *     os   .
          */
         void Print(std::ostream& os, Context& context) override;
+        //  ,  Print,   __str__   out   
+        void AppendTo(std::string& out, Context& context) override;
+
+        [[nodiscard]] TypeTag GetTypeTag() const override;
 
         /*
          *     method,   actual_args .
@@ -175,17 +770,61 @@ namespace runtime {
         ObjectHolder Call(const std::string& method, const std::vector<ObjectHolder>& actual_args,
             Context& context);
 
+        //       method (,  InlineCache).
+        //        actual_args,  runtime_error
+        ObjectHolder Call(const Method& method, const std::vector<ObjectHolder>& actual_args,
+            Context& context);
+
+        //   method   frame,   self   .
+        //   (Completion::TAIL_CALL)       ,
+        //       
+        ObjectHolder CallInFrame(const Method& method, Closure& frame, Context& context);
+
         //  true,     method,  argument_count 
         [[nodiscard]] bool HasMethod(const std::string& method, size_t argument_count) const;
 
-        //    Closure,   
+        //      name  nullptr,    
+        [[nodiscard]] ObjectHolder* FindField(const std::string& name);
+        [[nodiscard]] const ObjectHolder* FindField(const std::string& name) const;
+
+        //   name  value,     .
+        //     
+        ObjectHolder& SetField(const std::string& name, ObjectHolder value);
+
+        //     nullptr,      
+        [[nodiscard]] const Shape* GetShape() const;
+
+        //     slot   
+        [[nodiscard]] ObjectHolder& GetSlot(size_t slot);
+
+        //  ,    
+        [[nodiscard]] const Class& GetClass() const;
+
+        /*
+         *    Closure,   .
+         *    :         ,
+         *       ( )  
+         */
         [[nodiscard]] Closure& Fields();
         //     Closure,   
         [[nodiscard]] const Closure& Fields() const;
 
+        //  C++-     nullptr
+        [[nodiscard]] NativeData* GetNativeData() const;
+
+        void Traverse(const std::function<void(const ObjectHolder&)>& visitor) const override;
+        void ClearReferences() override;
+
     private:
+        Closure& ToDictionaryMode() const;
+        //   __str__       
+        ObjectHolder CallStr(const Method& method, Context& context);
+
         const Class& cls_;
-        Closure closure_;
+        mutable const Shape* shape_;
+        mutable std::vector<ObjectHolder> slots_;
+        mutable std::unique_ptr<Closure> dictionary_;
+        std::unique_ptr<NativeData> native_;
     };
 
     /*
@@ -207,38 +846,56 @@ namespace runtime {
      *  context      __lt__
      */
     bool Less(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context);
-    //  ,  Equal(lhs, rhs, context)
+
+    /*
+     *      ,  Equal  Less.
+     *  lhs -     (__ne__, __gt__, __le__, __ge__),  .
+     *      :
+     * lhs != rhs -  not (lhs == rhs), lhs > rhs -  not (lhs < rhs) and not (lhs == rhs),
+     * lhs <= rhs -  not (lhs > rhs), lhs >= rhs -  not (lhs < rhs)
+     */
     bool NotEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context);
-    //   lhs>rhs,   Equal  Less
     bool Greater(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context);
-    //   lhs<=rhs,   Equal  Less
     bool LessOrEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context);
-    //  ,  Less(lhs, rhs, context)
     bool GreaterOrEqual(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context);
 
+    /*
+     *     . , ,  Bool  None   ,
+     *   -    __hash__,     .
+     *      runtime_error.
+     *
+     *  context      __hash__
+     */
+    size_t Hash(const ObjectHolder& object, Context& context);
+
     // -,   .
     //           output
     struct DummyContext : Context {
-        std::ostream& GetOutputStream() override {
-            return output;
+        OutputSink& GetOutput() override {
+            return sink;
         }
 
         std::ostringstream output;
+        StreamOutputSink sink{ output };
     };
 
-    //  ,       output,   
+    //  ,       output    sink,   
     class SimpleContext : public runtime::Context {
     public:
         explicit SimpleContext(std::ostream& output)
-            : output_(output) {
+            : sink_(std::make_unique<StreamOutputSink>(output)) {
+        }
+
+        explicit SimpleContext(std::unique_ptr<OutputSink> sink)
+            : sink_(std::move(sink)) {
         }
 
-        std::ostream& GetOutputStream() override {
-            return output_;
+        OutputSink& GetOutput() override {
+            return *sink_;
         }
 
     private:
-        std::ostream& output_;
+        std::unique_ptr<OutputSink> sink_;
     };
 
 }  // namespace runtime
\ No newline at end of file
@@ -1,7 +1,14 @@
+#include "bigint.h"
+#include "collections.h"
 #include "runtime.h"
 #include "test_runner_p.h"
 
+#include <chrono>
 #include <functional>
+#include <limits>
+#include <thread>
+
+#include <unistd.h>
 
 using namespace std;
 
@@ -282,6 +289,55 @@ namespace runtime {
             }
         }
 
+        void TestTruthinessHooks() {
+            DummyContext context;
+            bool bool_result = false;
+            int64_t len_result = 0;
+            auto bool_body = [&bool_result, &context](Closure& closure, Context& ctx) {
+                ASSERT_EQUAL(&context, &ctx);
+                ASSERT(closure.count("self"s) == 1);
+                return MakeBool(bool_result);
+            };
+            auto len_body = [&len_result](Closure&, Context&) {
+                return ObjectHolder::Own(Number{ len_result });
+            };
+
+            vector<Method> bool_methods;
+            bool_methods.push_back({ "__bool__"s, {}, make_unique<TestMethodBody>(bool_body) });
+            bool_methods.push_back({ "__len__"s, {}, make_unique<TestMethodBody>(len_body) });
+            Class bool_cls{ "WithBool"s, std::move(bool_methods), nullptr };
+
+            vector<Method> len_methods;
+            len_methods.push_back({ "__len__"s, {}, make_unique<TestMethodBody>(len_body) });
+            Class len_cls{ "WithLen"s, std::move(len_methods), nullptr };
+
+            Class plain_cls{ "Plain"s, {}, nullptr };
+
+            const ObjectHolder with_bool = ObjectHolder::Own(ClassInstance{ bool_cls });
+            const ObjectHolder with_len = ObjectHolder::Own(ClassInstance{ len_cls });
+            const ObjectHolder plain = ObjectHolder::Own(ClassInstance{ plain_cls });
+
+            // __bool__    __len__
+            len_result = 5;
+            ASSERT(!IsTrue(with_bool, context));
+            bool_result = true;
+            len_result = 0;
+            ASSERT(IsTrue(with_bool, context));
+
+            ASSERT(!IsTrue(with_len, context));
+            len_result = 3;
+            ASSERT(IsTrue(with_len, context));
+
+            ASSERT(!IsTrue(plain, context));
+            //     
+            ASSERT(!IsTrue(with_bool));
+            ASSERT_EQUAL(context.GetCallStack().GetDepth(), 0U);
+
+            ASSERT(IsTrue(MakeBool(true), context));
+            ASSERT(!IsTrue(MakeBool(false), context));
+            ASSERT(!MakeBool(true).IsOwning());
+        }
+
         void TestComparison() {
             auto test_equal = [](const ObjectHolder& lhs, const ObjectHolder& rhs, bool equality_result) {
                 DummyContext ctx;
@@ -474,6 +530,44 @@ namespace runtime {
             }
         }
 
+        void TestComparisonDunders() {
+            DummyContext context;
+            std::vector<std::string> calls;
+            auto make_body = [&calls, &context](std::string name, bool result) {
+                return make_unique<TestMethodBody>([&calls, &context, name, result](Closure&, Context& ctx) {
+                    ASSERT_EQUAL(&context, &ctx);
+                    calls.push_back(name);
+                    return ObjectHolder::Own(Bool{ result });
+                });
+            };
+
+            vector<Method> methods;
+            methods.push_back({ "__eq__"s, { "rhs"s }, make_body("eq"s, false) });
+            methods.push_back({ "__lt__"s, { "rhs"s }, make_body("lt"s, false) });
+            methods.push_back({ "__gt__"s, { "rhs"s }, make_body("gt"s, true) });
+            methods.push_back({ "__le__"s, { "rhs"s }, make_body("le"s, true) });
+            methods.push_back({ "__ge__"s, { "rhs"s }, make_body("ge"s, true) });
+            methods.push_back({ "__ne__"s, { "rhs"s }, make_body("ne"s, true) });
+            Class cls{ "Ordered"s, std::move(methods), nullptr };
+            ClassInstance lhs{ cls };
+            ClassInstance rhs{ cls };
+            const ObjectHolder lhs_holder = ObjectHolder::Share(lhs);
+            const ObjectHolder rhs_holder = ObjectHolder::Share(rhs);
+
+            ASSERT(Greater(lhs_holder, rhs_holder, context));
+            ASSERT(LessOrEqual(lhs_holder, rhs_holder, context));
+            ASSERT(GreaterOrEqual(lhs_holder, rhs_holder, context));
+            ASSERT(NotEqual(lhs_holder, rhs_holder, context));
+            ASSERT_EQUAL(calls, (std::vector{ "gt"s, "le"s, "ge"s, "ne"s }));
+            ASSERT_EQUAL(context.GetCallStack().GetDepth(), 0U);
+
+            //        
+            ASSERT(Less(ObjectHolder::Own(Number{ 1 }), MakeInteger(BigInt::FromString("100000000000000000000"s)), context));
+            ASSERT_THROWS(Less(lhs_holder, ObjectHolder::Own(Number{ 1 }), context), runtime_error);
+            ASSERT_THROWS(Greater(ObjectHolder::None(), ObjectHolder::None(), context), runtime_error);
+            ASSERT(!NotEqual(ObjectHolder::None(), ObjectHolder::None(), context));
+        }
+
         void TestClass() {
             vector<Method> methods;
             Closure* passed_closure = nullptr;
@@ -529,6 +623,568 @@ namespace runtime {
             ASSERT_THROWS(instance.Call("missing_method"s, {}, ctx), runtime_error);
         }
 
+        void TestInstanceShapes() {
+            Class cls{ "Point"s, {}, nullptr };
+            ClassInstance a{ cls };
+            ClassInstance b{ cls };
+            ClassInstance c{ cls };
+            ASSERT_EQUAL(a.GetShape(), cls.GetRootShape());
+
+            a.SetField("x"s, ObjectHolder::Own(Number{ 1 }));
+            a.SetField("y"s, ObjectHolder::Own(Number{ 2 }));
+            b.SetField("x"s, ObjectHolder::Own(Number{ 3 }));
+            b.SetField("y"s, ObjectHolder::Own(Number{ 4 }));
+            c.SetField("y"s, ObjectHolder::Own(Number{ 5 }));
+            c.SetField("x"s, ObjectHolder::Own(Number{ 6 }));
+
+            ASSERT_EQUAL(a.GetShape(), b.GetShape());
+            ASSERT(a.GetShape() != c.GetShape());
+            ASSERT_EQUAL(a.GetShape()->FieldCount(), 2U);
+            ASSERT_EQUAL(a.GetShape()->FindSlot("y"s), 1U);
+            ASSERT_EQUAL(c.GetShape()->FindSlot("y"s), 0U);
+            ASSERT_EQUAL(a.GetShape()->FindSlot("z"s), Shape::NO_SLOT);
+
+            a.SetField("x"s, ObjectHolder::Own(Number{ 7 }));
+            ASSERT_EQUAL(a.GetShape(), b.GetShape());
+            ASSERT_EQUAL(a.FindField("x"s)->TryAs<Number>()->GetValue(), 7);
+            ASSERT(a.FindField("z"s) == nullptr);
+
+            // Fields() switches the instance to dictionary mode, other instances keep their shape
+            a.Fields()["z"s] = ObjectHolder::Own(Number{ 8 });
+            ASSERT(a.GetShape() == nullptr);
+            ASSERT_EQUAL(a.Fields().size(), 3U);
+            ASSERT_EQUAL(a.FindField("y"s)->TryAs<Number>()->GetValue(), 2);
+            ASSERT_EQUAL(a.FindField("z"s)->TryAs<Number>()->GetValue(), 8);
+            a.SetField("w"s, ObjectHolder::None());
+            ASSERT_EQUAL(a.Fields().count("w"s), 1U);
+            ASSERT_EQUAL(b.GetShape()->FieldCount(), 2U);
+        }
+
+        void TestFieldCache() {
+            Class cls{ "Point"s, {}, nullptr };
+            ClassInstance a{ cls };
+            ClassInstance b{ cls };
+            ClassInstance c{ cls };
+            for (ClassInstance* instance : { &a, &b }) {
+                instance->SetField("x"s, ObjectHolder::Own(Number{ 1 }));
+                instance->SetField("y"s, ObjectHolder::Own(Number{ 2 }));
+            }
+            c.SetField("y"s, ObjectHolder::Own(Number{ 3 }));
+
+            //  CacheCountingScope    
+            FieldCache quiet_cache;
+            ASSERT(quiet_cache.Find(a, "y"s) == a.FindField("y"s));
+            ASSERT(quiet_cache.Find(b, "y"s) == b.FindField("y"s));
+            ASSERT_EQUAL(quiet_cache.GetHits() + quiet_cache.GetMisses(), 0U);
+
+            CacheCountingScope counting;
+            FieldCache cache;
+            ASSERT(cache.Find(a, "y"s) == a.FindField("y"s));
+            ASSERT(cache.Find(b, "y"s) == b.FindField("y"s));
+            //       
+            ASSERT_EQUAL(cache.GetMisses(), 1U);
+            ASSERT_EQUAL(cache.GetHits(), 1U);
+            //          
+            ASSERT(cache.Find(c, "y"s) == c.FindField("y"s));
+            ASSERT_EQUAL(cache.GetMisses(), 2U);
+            FieldCache missing_cache;
+            ASSERT(missing_cache.Find(c, "x"s) == nullptr);
+            ASSERT(missing_cache.Find(c, "x"s) == nullptr);
+            ASSERT_EQUAL(missing_cache.GetMisses(), 2U);
+
+            //           
+            a.Fields()["z"s] = ObjectHolder::None();
+            ASSERT(cache.Find(a, "y"s) == a.FindField("y"s));
+            ASSERT_EQUAL(cache.GetMisses(), 3U);
+            ASSERT_EQUAL(cache.GetHits(), 1U);
+
+            Closure closure = { {"a"s, ObjectHolder::None()}, {"b"s, ObjectHolder::None()} };
+            size_t hint = 0;
+            ASSERT(closure.FindWithHint("b"s, hint) == &closure.at("b"s));
+            ASSERT_EQUAL(hint, 1U);
+            ASSERT(closure.FindWithHint("c"s, hint) == nullptr);
+            ASSERT_EQUAL(hint, 1U);
+        }
+
+        void TestClosure() {
+            Closure closure = { {"a"s, ObjectHolder::Own(Number{ 1 })}, {"b"s, ObjectHolder::None()} };
+            ASSERT_EQUAL(closure.size(), 2U);
+            ASSERT_EQUAL(closure.count("a"s), 1U);
+            ASSERT(closure.find("c"s) == closure.end());
+            ASSERT_THROWS(closure.at("c"s), out_of_range);
+
+            // Past the linear lookup range the table switches to a hash index
+            for (int i = 0; i < 100; ++i) {
+                closure["v"s + to_string(i)] = ObjectHolder::Own(Number{ i });
+            }
+            ASSERT_EQUAL(closure.size(), 102U);
+            for (int i = 0; i < 100; ++i) {
+                ASSERT_EQUAL(closure.at("v"s + to_string(i)).TryAs<Number>()->GetValue(), i);
+            }
+            ASSERT(!closure.emplace("v7"s, ObjectHolder::None()).second);
+            ASSERT_EQUAL(closure.erase("v7"s), 1U);
+            ASSERT_EQUAL(closure.erase("v7"s), 0U);
+            ASSERT_EQUAL(closure.count("v7"s), 0U);
+            ASSERT_EQUAL(closure.at("v8"s).TryAs<Number>()->GetValue(), 8);
+
+            closure.clear();
+            ASSERT(closure.empty());
+            ASSERT_EQUAL(closure.count("a"s), 0U);
+        }
+
+        void TestCallStackReusesFrames() {
+            DummyContext context;
+            CallStack& stack = context.GetCallStack();
+            Closure* first = nullptr;
+            {
+                CallStack::Frame frame(stack);
+                ASSERT_EQUAL(stack.GetDepth(), 1U);
+                (*frame)["x"s] = ObjectHolder::Own(Number{ 1 });
+                first = &*frame;
+                {
+                    CallStack::Frame nested(stack);
+                    ASSERT_EQUAL(stack.GetDepth(), 2U);
+                    ASSERT(&*nested != first);
+                }
+                ASSERT_EQUAL(frame->size(), 1U);
+            }
+            ASSERT_EQUAL(stack.GetDepth(), 0U);
+
+            CallStack::Frame frame(stack);
+            ASSERT_EQUAL(&*frame, first);
+            ASSERT(frame->empty());
+        }
+
+        void TestBigInt() {
+            const BigInt max = numeric_limits<int64_t>::max();
+            const BigInt min = numeric_limits<int64_t>::min();
+            ASSERT_EQUAL((max + 1).ToString(), "9223372036854775808"s);
+            ASSERT_EQUAL((min - 1).ToString(), "-9223372036854775809"s);
+            ASSERT(!(max + 1).FitsInt64());
+            ASSERT((max + 1 - 1).FitsInt64());
+            ASSERT_EQUAL((max + 1 - 1).ToInt64(), numeric_limits<int64_t>::max());
+            ASSERT_EQUAL(min.ToInt64(), numeric_limits<int64_t>::min());
+            ASSERT_EQUAL(BigInt::FromString("-123456789012345678901234567890"s).ToString(),
+                         "-123456789012345678901234567890"s);
+            ASSERT_THROWS(BigInt::FromString("12a"s), std::invalid_argument);
+
+            // 3^400  ,      
+            BigInt power = 1;
+            for (int i = 0; i < 400; ++i) {
+                power = power * 3;
+            }
+            const BigInt square = power * power;
+            BigInt expected = 1;
+            for (int i = 0; i < 800; ++i) {
+                expected = expected * 3;
+            }
+            ASSERT_EQUAL(square, expected);
+            ASSERT_EQUAL(square / power, power);
+            ASSERT_EQUAL((square + 1) / power, power);
+            ASSERT_EQUAL((square - 1) / power, power - 1);
+            ASSERT_EQUAL((-square) / power, -power);
+            ASSERT_THROWS(square / BigInt(), std::runtime_error);
+
+            ASSERT(min - 1 < min);
+            ASSERT(-square < power);
+            ASSERT(!(square < power));
+
+            DummyContext context;
+            const ObjectHolder big = MakeInteger(max + 1);
+            ASSERT(big.TryAs<BigNumber>() != nullptr);
+            ASSERT(MakeInteger(max).TryAs<Number>() != nullptr);
+            ASSERT(IsTrue(big));
+            ASSERT(Less(ObjectHolder::Own(Number{ 1 }), big, context));
+            ASSERT(Equal(IntegerSub(big, ObjectHolder::Own(Number{ 1 })), ObjectHolder::Own(Number{ max.ToInt64() }), context));
+            big->Print(context.output, context);
+            ASSERT_EQUAL(context.output.str(), "9223372036854775808"s);
+        }
+
+        void TestList() {
+            DummyContext context;
+            List list;
+            ASSERT(!IsTrue(ObjectHolder::Share(list)));
+
+            list.Append(ObjectHolder::Own(Number{ 1 }));
+            list.Append(ObjectHolder::Own(String{ "a"s }));
+            list.Append(ObjectHolder::None());
+            ASSERT_EQUAL(list.Size(), 3U);
+            ASSERT(IsTrue(ObjectHolder::Share(list)));
+            ASSERT(list.At(-1).Get() == nullptr);
+            ASSERT_EQUAL(static_cast<String&>(*list.At(1)).GetValue(), "a"s);
+            ASSERT_THROWS((void)list.At(3), std::runtime_error);
+            ASSERT_THROWS((void)list.At(-4), std::runtime_error);
+
+            list.Print(context.output, context);
+            ASSERT_EQUAL(context.output.str(), "[1, 'a', None]"s);
+
+            vector<ObjectHolder> args;
+            ASSERT(list.CallMethod("pop"s, args).Get() == nullptr);
+            args.push_back(ObjectHolder::Own(Number{ 0 }));
+            ASSERT_EQUAL(static_cast<Number&>(*list.CallMethod("pop"s, args)).GetValue(), 1);
+            ASSERT_EQUAL(list.Size(), 1U);
+            args.assign(2, ObjectHolder::None());
+            ASSERT_THROWS(list.CallMethod("append"s, args), std::runtime_error);
+
+            // ,   ,    
+            ObjectHolder self_ref = ObjectHolder::Own(List{});
+            static_cast<List&>(*self_ref).Append(self_ref);
+            context.output.str(""s);
+            self_ref->Print(context.output, context);
+            ASSERT_EQUAL(context.output.str(), "[[...]]"s);
+            static_cast<List&>(*self_ref).ClearReferences();
+
+            auto make_list = [](std::initializer_list<int64_t> values) {
+                List result;
+                for (int64_t value : values) {
+                    result.Append(ObjectHolder::Own(Number{ value }));
+                }
+                return ObjectHolder::Own(std::move(result));
+            };
+            ASSERT(Equal(make_list({ 1, 2 }), make_list({ 1, 2 }), context));
+            ASSERT(NotEqual(make_list({ 1, 2 }), make_list({ 1 }), context));
+            ASSERT(Less(make_list({ 1, 2 }), make_list({ 1, 3 }), context));
+            ASSERT(Less(make_list({ 1 }), make_list({ 1, 0 }), context));
+            ASSERT(GreaterOrEqual(make_list({ 2 }), make_list({ 1, 5 }), context));
+        }
+
+        void TestDict() {
+            DummyContext context;
+            Dict dict;
+            ASSERT(!IsTrue(ObjectHolder::Share(dict)));
+
+            dict.Set(ObjectHolder::Own(String{ "a"s }), ObjectHolder::Own(Number{ 1 }), context);
+            dict.Set(ObjectHolder::Own(Number{ 1 }), ObjectHolder::None(), context);
+            dict.Set(ObjectHolder::Own(Bool{ true }), ObjectHolder::Own(String{ "yes"s }), context);
+            dict.Set(ObjectHolder::None(), ObjectHolder::Own(Number{ 0 }), context);
+            ASSERT_EQUAL(dict.Size(), 4U);
+            ASSERT(IsTrue(ObjectHolder::Share(dict)));
+
+            //     ,         bool
+            ASSERT(dict.Find(ObjectHolder::Own(Number{ 1 }), context)->Get() == nullptr);
+            ASSERT_EQUAL(static_cast<String&>(*dict.At(ObjectHolder::Own(Bool{ true }), context)).GetValue(), "yes"s);
+            ASSERT(dict.Find(ObjectHolder::Own(String{ "b"s }), context) == nullptr);
+            ASSERT_THROWS((void)dict.At(ObjectHolder::Own(String{ "b"s }), context), std::runtime_error);
+            ASSERT_THROWS(dict.Set(ObjectHolder::Own(List{}), ObjectHolder::None(), context), std::runtime_error);
+
+            dict.Set(ObjectHolder::Own(String{ "a"s }), ObjectHolder::Own(Number{ 2 }), context);
+            ASSERT_EQUAL(dict.Size(), 4U);
+            dict.Print(context.output, context);
+            ASSERT_EQUAL(context.output.str(), "{'a': 2, 1: None, True: 'yes', None: 0}"s);
+
+            //    :  ,     
+            Dict numbers;
+            for (int64_t i = 0; i < 10000; ++i) {
+                numbers.Set(ObjectHolder::Own(Number{ i * 1024 }), ObjectHolder::Own(Number{ i }), context);
+            }
+            for (int64_t i = 0; i < 10000; i += 2) {
+                ASSERT(numbers.Erase(ObjectHolder::Own(Number{ i * 1024 }), context));
+            }
+            ASSERT(!numbers.Erase(ObjectHolder::Own(Number{ 0 }), context));
+            ASSERT_EQUAL(numbers.Size(), 5000U);
+            for (int64_t i = 0; i < 10000; ++i) {
+                const ObjectHolder* value = numbers.Find(ObjectHolder::Own(Number{ i * 1024 }), context);
+                ASSERT_EQUAL(value != nullptr, i % 2 == 1);
+                if (value) {
+                    ASSERT_EQUAL(static_cast<const Number&>(**value).GetValue(), i);
+                }
+            }
+            int64_t expected = 1;
+            numbers.ForEach([&expected](const ObjectHolder&, const ObjectHolder& value) {
+                ASSERT_EQUAL(static_cast<const Number&>(*value).GetValue(), expected);
+                expected += 2;
+            });
+        }
+
+        void TestStringMethods() {
+            auto call = [](const std::string& str, const std::string& method, std::vector<ObjectHolder> args) {
+                return CallStringMethod(str, method, args);
+            };
+            auto text = [](const std::string& str) {
+                return ObjectHolder::Own(String{ str });
+            };
+            auto number = [](const ObjectHolder& value) {
+                return static_cast<const Number&>(*value).GetValue();
+            };
+            auto print = [](const ObjectHolder& value) {
+                DummyContext context;
+                value->Print(context.output, context);
+                return context.output.str();
+            };
+
+            ASSERT_EQUAL(number(call("abcabc"s, "find"s, { text("ca"s) })), 2);
+            ASSERT_EQUAL(number(call("abcabc"s, "find"s, { text("cb"s) })), -1);
+            ASSERT_EQUAL(number(call("abc"s, "find"s, { text(""s) })), 0);
+            ASSERT_EQUAL(number(call("ab"s, "find"s, { text("abc"s) })), -1);
+            //         memmem
+            ASSERT_EQUAL(number(call(std::string(1000, 'a') + "ab"s, "find"s, { text("ab"s) })), 1000);
+            ASSERT_EQUAL(number(call(std::string(1000, 'a'), "find"s, { text("ab"s) })), -1);
+            ASSERT(IsTrue(call("ERROR x"s, "startswith"s, { text("ERROR"s) })));
+            ASSERT(!IsTrue(call("ERR"s, "startswith"s, { text("ERROR"s) })));
+            ASSERT(IsTrue(call("a.log"s, "endswith"s, { text(".log"s) })));
+            ASSERT_EQUAL(print(call("  a b\t c "s, "split"s, {})), "['a', 'b', 'c']"s);
+            ASSERT_EQUAL(print(call("a,,b,"s, "split"s, { text(","s) })), "['a', '', 'b', '']"s);
+            ASSERT_EQUAL(print(call(", "s, "join"s, { call("a b"s, "split"s, {}) })), "a, b"s);
+            ASSERT_EQUAL(print(call("MiXed 1"s, "upper"s, {})), "MIXED 1"s);
+            ASSERT_EQUAL(print(call("MiXed 1"s, "lower"s, {})), "mixed 1"s);
+            ASSERT_THROWS(call("a"s, "find"s, { ObjectHolder::Own(Number{ 1 }) }), std::runtime_error);
+            ASSERT_THROWS(call("a"s, "split"s, { text(""s) }), std::runtime_error);
+            ASSERT_THROWS(call("a"s, "reverse"s, {}), std::runtime_error);
+
+            using Bounds = std::pair<size_t, size_t>;
+            const ObjectHolder none;
+            ASSERT(SliceBounds(none, none, 5) == Bounds(0, 5));
+            ASSERT(SliceBounds(ObjectHolder::Own(Number{ 1 }), ObjectHolder::Own(Number{ -1 }), 5) == Bounds(1, 4));
+            ASSERT(SliceBounds(ObjectHolder::Own(Number{ -10 }), ObjectHolder::Own(Number{ 10 }), 5) == Bounds(0, 5));
+            ASSERT(SliceBounds(ObjectHolder::Own(Number{ 4 }), ObjectHolder::Own(Number{ 2 }), 5) == Bounds(4, 4));
+        }
+
+        void TestOutputSink() {
+            {
+                //         Commit,    
+                ostringstream out;
+                StreamOutputSink sink{ out };
+                sink.Write("x = "sv);
+                sink.WriteInteger(numeric_limits<int64_t>::min());
+                sink.GetStream() << ' ' << 1.5;
+                sink.Write(' ');
+                sink.WriteInteger(0);
+                ASSERT(out.str().empty());
+                sink.Write('\n');
+                sink.Commit();
+                ASSERT_EQUAL(out.str(), "x = -9223372036854775808 1.5 0\n"s);
+                ASSERT_EQUAL(sink.GetBufferedSize(), 0U);
+            }
+            {
+                //   ,      
+                int fds[2];
+                ASSERT(pipe(fds) == 0);
+                string received;
+                auto read_all = [&] {
+                    char chunk[256];
+                    ssize_t n = 0;
+                    while ((n = read(fds[0], chunk, sizeof(chunk))) > 0) {
+                        received.append(chunk, static_cast<size_t>(n));
+                    }
+                };
+                {
+                    FdOutputSink sink{ fds[1], 16 };
+                    sink.Write("12345\n"sv);
+                    sink.Commit();
+                    ASSERT_EQUAL(sink.GetWriteCalls(), 0U);
+                    sink.Write("abcdefghij\n"sv);
+                    sink.Commit();
+                    ASSERT_EQUAL(sink.GetWriteCalls(), 1U);
+                    sink.Write('>');
+                    sink.Write(string(40, 'z'));
+                    ASSERT_EQUAL(sink.GetWriteCalls(), 2U);
+                    ASSERT_EQUAL(sink.GetBufferedSize(), 0U);
+                    sink.Write("tail"sv);
+                }
+                close(fds[1]);
+                read_all();
+                close(fds[0]);
+                ASSERT_EQUAL(received, "12345\nabcdefghij\n>"s + string(40, 'z') + "tail"s);
+            }
+            {
+                FdOutputSink sink{ -1 };
+                sink.Write("lost"sv);
+                ASSERT_THROWS(sink.Flush(), runtime_error);
+            }
+        }
+
+        void TestAsyncOutputSink() {
+            //   fd      received
+            auto read_all = [](int fd, string& received, bool slow) {
+                char chunk[512];
+                ssize_t n = 0;
+                while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+                    received.append(chunk, static_cast<size_t>(n));
+                    if (slow) {
+                        this_thread::sleep_for(chrono::microseconds(20));
+                    }
+                }
+            };
+            auto line = [](int i) {
+                string text = to_string(10'000'000 + i);
+                text.push_back('\n');
+                return text;
+            };
+            {
+                //  :     ,      
+                int fds[2];
+                ASSERT(pipe(fds) == 0);
+                string received;
+                thread reader(read_all, fds[0], ref(received), true);
+                string expected;
+                {
+                    AsyncFdOutputSink sink{ fds[1], Backpressure::BLOCK, 2, 64 };
+                    for (int i = 0; i < 5000; ++i) {
+                        sink.WriteInteger(10'000'000 + i);
+                        sink.Write('\n');
+                        sink.Commit();
+                        expected += line(i);
+                    }
+                    sink.WaitWritten();
+                    ASSERT_EQUAL(sink.GetDroppedBytes(), 0U);
+                    sink.Write("tail"sv);
+                }
+                close(fds[1]);
+                reader.join();
+                close(fds[0]);
+                ASSERT_EQUAL(received, expected + "tail"s);
+            }
+            {
+                //      ,    
+                int fds[2];
+                ASSERT(pipe(fds) == 0);
+                constexpr int lines = 500'000;
+                size_t dropped = 0;
+                string received;
+                thread reader;
+                {
+                    AsyncFdOutputSink sink{ fds[1], Backpressure::DROP, 2, 1024 };
+                    for (int i = 0; i < lines; ++i) {
+                        sink.WriteInteger(10'000'000 + i);
+                        sink.Write('\n');
+                        sink.Commit();
+                    }
+                    dropped = sink.GetDroppedBytes();
+                    ASSERT(dropped > 0);
+                    reader = thread(read_all, fds[0], ref(received), false);
+                }
+                close(fds[1]);
+                reader.join();
+                close(fds[0]);
+                //       
+                ASSERT_EQUAL(received.size() + dropped, size_t{ lines } * 9);
+                ASSERT_EQUAL(received.substr(received.size() - 9), line(lines - 1));
+                int previous = -1;
+                for (size_t pos = 0; pos < received.size(); pos += 9) {
+                    const int current = stoi(received.substr(pos, 8));
+                    ASSERT(current > previous);
+                    previous = current;
+                }
+            }
+            {
+                AsyncFdOutputSink sink{ -1 };
+                sink.Write("lost"sv);
+                ASSERT_THROWS(sink.WaitWritten(), runtime_error);
+                sink.Write("lost"sv);
+                ASSERT_THROWS(sink.Flush(), runtime_error);
+            }
+        }
+
+        void TestAppendTo() {
+            DummyContext ctx;
+            // AppendTo   ,   Print,    
+            auto check = [&ctx](Object& object, const string& expected) {
+                ostringstream printed;
+                object.Print(printed, ctx);
+                ASSERT_EQUAL(printed.str(), expected);
+                string out = "> "s;
+                object.AppendTo(out, ctx);
+                ASSERT_EQUAL(out, "> "s + expected);
+            };
+            Number min_number{ numeric_limits<int64_t>::min() };
+            check(min_number, "-9223372036854775808"s);
+            Number zero{ 0 };
+            check(zero, "0"s);
+            String text{ "hello"s };
+            check(text, "hello"s);
+            Bool yes{ true };
+            check(yes, "True"s);
+            Range range{ 1, 10, 3 };
+            check(range, "range(1, 10, 3)"s);
+
+            vector<Method> methods;
+            methods.push_back({ "__str__", {}, make_unique<TestMethodBody>([](Closure& closure, Context&) {
+                return ObjectHolder::Own(String{ "point "s + to_string(closure.count("self"s)) });
+            }) });
+            Class point_cls{ "Point"s, move(methods), nullptr };
+            ObjectHolder point = ObjectHolder::Own(ClassInstance{ point_cls });
+            check(*point, "point 1"s);
+
+            List list{ { ObjectHolder::Own(Number{ 1 }), ObjectHolder::Own(String{ "a"s }), ObjectHolder::None(), point } };
+            check(list, "[1, 'a', None, point 1]"s);
+            Dict dict;
+            dict.Set(ObjectHolder::Own(String{ "k"s }), ObjectHolder::Own(List{}), ctx);
+            check(dict, "{'k': []}"s);
+
+            Class plain_cls{ "Plain"s, {}, nullptr };
+            ClassInstance plain{ plain_cls };
+            ostringstream address;
+            address << &plain;
+            check(plain, address.str());
+        }
+
+        void TestRangeAndIterators() {
+            DummyContext context;
+            const int64_t max = std::numeric_limits<int64_t>::max();
+            const int64_t min = std::numeric_limits<int64_t>::min();
+            ASSERT_EQUAL(Range(0, 5, 1).Size(), 5U);
+            ASSERT_EQUAL(Range(1, 8, 3).Size(), 3U);
+            ASSERT_EQUAL(Range(5, 0, -2).Size(), 3U);
+            ASSERT_EQUAL(Range(5, 5, 1).Size(), 0U);
+            ASSERT_EQUAL(Range(0, 5, -1).Size(), 0U);
+            ASSERT_EQUAL(Range(min, max, 1).Size(), static_cast<uint64_t>(max) * 2 + 1);
+            ASSERT_EQUAL(Range(5, 0, -2).At(-1), 1);
+            ASSERT_THROWS((void)Range(0, 5, 1).At(5), std::runtime_error);
+            ASSERT_THROWS(Range(0, 5, 0), std::runtime_error);
+            ASSERT(!IsTrue(ObjectHolder::Own(Range(3, 3, 1))));
+
+            Range(1, 7, 2).Print(context.output, context);
+            context.output << ' ';
+            Range(0, 3, 1).Print(context.output, context);
+            ASSERT_EQUAL(context.output.str(), "range(1, 7, 2) range(0, 3)"s);
+
+            //  ,     , 
+            auto iterator = MakeIterator(ObjectHolder::Own(Range(max - 2, max, 1)), context);
+            ObjectHolder slot;
+            ASSERT(iterator->Next(slot, context));
+            const Object* first = slot.Get();
+            ASSERT(iterator->Next(slot, context));
+            ASSERT(slot.Get() == first);
+            ASSERT_EQUAL(static_cast<Number&>(*slot).GetValue(), max - 1);
+            ASSERT(!iterator->Next(slot, context));
+
+            //      ,      
+            iterator = MakeIterator(ObjectHolder::Own(String{ "ab"s }), context);
+            ASSERT(iterator->Next(slot, context));
+            ObjectHolder saved = slot;
+            ASSERT(iterator->Next(slot, context));
+            ASSERT_EQUAL(static_cast<String&>(*saved).GetValue(), "a"s);
+            ASSERT_EQUAL(static_cast<String&>(*slot).GetValue(), "b"s);
+
+            ObjectHolder dict = ObjectHolder::Own(Dict{});
+            auto& dict_ref = static_cast<Dict&>(*dict);
+            dict_ref.Set(ObjectHolder::Own(Number{ 1 }), ObjectHolder::None(), context);
+            dict_ref.Set(ObjectHolder::Own(Number{ 2 }), ObjectHolder::None(), context);
+            iterator = MakeIterator(dict, context);
+            ASSERT(iterator->Next(slot, context));
+            ASSERT_EQUAL(static_cast<Number&>(*slot).GetValue(), 1);
+            dict_ref.Set(ObjectHolder::Own(Number{ 3 }), ObjectHolder::None(), context);
+            ASSERT_THROWS(iterator->Next(slot, context), std::runtime_error);
+
+            //       ,     
+            for (int i = 4; i <= 7; ++i) {
+                dict_ref.Set(ObjectHolder::Own(Number{ i }), ObjectHolder::None(), context);
+            }
+            iterator = MakeIterator(dict, context);
+            ASSERT(iterator->Next(slot, context));
+            ASSERT(dict_ref.Erase(ObjectHolder::Own(Number{ 1 }), context));
+            dict_ref.Set(ObjectHolder::Own(Number{ 100 }), ObjectHolder::None(), context);
+            ASSERT_EQUAL(dict_ref.Size(), 7U);
+            ASSERT_THROWS(iterator->Next(slot, context), std::runtime_error);
+            //       
+            iterator = MakeIterator(dict, context);
+            ASSERT(iterator->Next(slot, context));
+            dict_ref.Set(ObjectHolder::Own(Number{ 2 }), ObjectHolder::Own(Number{ 0 }), context);
+            ASSERT(iterator->Next(slot, context));
+
+            ASSERT_THROWS(MakeIterator(ObjectHolder::Own(Number{ 1 }), context), std::runtime_error);
+        }
+
     }  // namespace
 
     void RunObjectsTests(TestRunner& tr) {
@@ -537,9 +1193,23 @@ namespace runtime {
         RUN_TEST(tr, runtime::TestBool);
         RUN_TEST(tr, runtime::TestMethodInvocation);
         RUN_TEST(tr, runtime::TestIsTrue);
+        RUN_TEST(tr, runtime::TestTruthinessHooks);
         RUN_TEST(tr, runtime::TestComparison);
+        RUN_TEST(tr, runtime::TestComparisonDunders);
         RUN_TEST(tr, runtime::TestClass);
         RUN_TEST(tr, runtime::TestClassInstance);
+        RUN_TEST(tr, runtime::TestInstanceShapes);
+        RUN_TEST(tr, runtime::TestFieldCache);
+        RUN_TEST(tr, runtime::TestClosure);
+        RUN_TEST(tr, runtime::TestCallStackReusesFrames);
+        RUN_TEST(tr, runtime::TestBigInt);
+        RUN_TEST(tr, runtime::TestList);
+        RUN_TEST(tr, runtime::TestDict);
+        RUN_TEST(tr, runtime::TestStringMethods);
+        RUN_TEST(tr, runtime::TestRangeAndIterators);
+        RUN_TEST(tr, runtime::TestAppendTo);
+        RUN_TEST(tr, runtime::TestOutputSink);
+        RUN_TEST(tr, runtime::TestAsyncOutputSink);
     }
 
     void RunObjectHolderTests(TestRunner& tr) {
@@ -1,6 +1,12 @@
 #include "statement.h"
 
+#include "bigint.h"
+#include "collections.h"
+#include "gc.h"
+
+#include <atomic>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 using namespace std;
@@ -12,8 +18,82 @@ namespace ast {
     using runtime::ObjectHolder;
 
     namespace {
-        const string ADD_METHOD = "__add__"s;
+        const string IADD_METHOD = "__iadd__"s;
         const string INIT_METHOD = "__init__"s;
+        const string SELF = "self"s;
+
+        //     int64.  true  
+        bool CheckedAdd(int64_t a, int64_t b, int64_t* res) {
+            return __builtin_add_overflow(a, b, res);
+        }
+
+        bool CheckedSub(int64_t a, int64_t b, int64_t* res) {
+            return __builtin_sub_overflow(a, b, res);
+        }
+
+        bool CheckedMult(int64_t a, int64_t b, int64_t* res) {
+            return __builtin_mul_overflow(a, b, res);
+        }
+
+        bool CheckedDiv(int64_t a, int64_t b, int64_t* res) {
+            if (b == 0) {
+                throw runtime_error("Zero division"s);
+            }
+            //      INT64_MIN / -1
+            if (b == -1 && a == numeric_limits<int64_t>::min()) {
+                return true;
+            }
+            *res = a / b;
+            return false;
+        }
+
+        bool CheckedOperation(ArithmeticOperation op, int64_t a, int64_t b, int64_t* res) {
+            switch (op) {
+            case ArithmeticOperation::ADD:
+                return CheckedAdd(a, b, res);
+            case ArithmeticOperation::SUB:
+                return CheckedSub(a, b, res);
+            case ArithmeticOperation::MULT:
+                return CheckedMult(a, b, res);
+            case ArithmeticOperation::DIV:
+                return CheckedDiv(a, b, res);
+            }
+            return true;
+        }
+
+        //      :    int64   BigNumber
+        using IntegerSlowOperation = ObjectHolder (*)(const ObjectHolder&, const ObjectHolder&);
+
+        IntegerSlowOperation IntegerSlowPath(ArithmeticOperation op) {
+            switch (op) {
+            case ArithmeticOperation::ADD:
+                return runtime::IntegerAdd;
+            case ArithmeticOperation::SUB:
+                return runtime::IntegerSub;
+            case ArithmeticOperation::MULT:
+                return runtime::IntegerMult;
+            case ArithmeticOperation::DIV:
+                break;
+            }
+            return runtime::IntegerDiv;
+        }
+
+        //  ,  ,       
+        struct OperatorMethods {
+            string direct;
+            string reflected;
+            string error;
+        };
+
+        const OperatorMethods& GetOperatorMethods(ArithmeticOperation op) {
+            static const OperatorMethods methods[] = {
+                { "__add__"s, "__radd__"s, "Unsupported operand types for +"s },
+                { "__sub__"s, "__rsub__"s, "Unsupported operand types for -"s },
+                { "__mul__"s, "__rmul__"s, "Unsupported operand types for *"s },
+                { "__truediv__"s, "__rtruediv__"s, "Unsupported operand types for /"s },
+            };
+            return methods[static_cast<size_t>(op)];
+        }
     }  // namespace
 
     ObjectHolder Assignment::Execute(Closure& closure, Context& context) {
@@ -26,34 +106,42 @@ namespace ast {
         , rv_(move(rv))
     {}
 
+    uint64_t NextConstantSerial() {
+        //        
+        static std::atomic<uint64_t> next_serial{ 1 };
+        return next_serial.fetch_add(1, std::memory_order_relaxed);
+    }
+
     VariableValue::VariableValue(const std::string& var_name)
-        : var_name_(var_name)
-        , dotted_ids_(0)
+        : dotted_ids_{ var_name }
     {}
 
     VariableValue::VariableValue(std::vector<std::string> dotted_ids)
-        : var_name_(""s)
-        , dotted_ids_(move(dotted_ids))
+        : dotted_ids_(move(dotted_ids))
+        , field_caches_(dotted_ids_.empty() ? 0 : dotted_ids_.size() - 1)
     {}
 
     ObjectHolder VariableValue::Execute(Closure& closure, [[maybe_unused]] Context& context) {
-        if (!var_name_.empty() && closure.count(var_name_)) {
-            return closure.at(var_name_);
+        const ObjectHolder* current = dotted_ids_.empty() ? nullptr : closure.FindWithHint(dotted_ids_[0], root_hint_);
+        if (!current) {
+            throw runtime_error("Variable error"s);
         }
-        else if (!dotted_ids_.empty()) {
-            if (dotted_ids_.size() == 1) {
-                return closure.at(dotted_ids_[0]);
+        //     :    -      
+        for (size_t i = 1; i < dotted_ids_.size(); ++i) {
+            if (current->GetTypeTag() != runtime::TypeTag::INSTANCE) {
+                throw runtime_error("Variable error"s);
             }
-            Closure tmp_closure;
-            for (size_t i = 0; i < dotted_ids_.size() - 1; ++i) {
-                string id = dotted_ids_[i];
-                tmp_closure = closure.at(id).TryAs<runtime::ClassInstance>()->Fields();
+            auto& cls_inst = static_cast<runtime::ClassInstance&>(**current);
+            current = field_caches_[i - 1].Find(cls_inst, dotted_ids_[i]);
+            if (!current) {
+                //        None
+                if (i + 1 == dotted_ids_.size()) {
+                    return ObjectHolder::None();
+                }
+                throw runtime_error("Variable error"s);
             }
-            return tmp_closure[dotted_ids_.back()];
-        }
-        else {
-            throw runtime_error("Variable error"s);
         }
+        return *current;
     }
 
     unique_ptr<Print> Print::Variable(const std::string& name) {
@@ -71,24 +159,31 @@ namespace ast {
     {}
 
     ObjectHolder Print::Execute(Closure& closure, Context& context) {
-        ostream& os = context.GetOutputStream();
+        runtime::OutputSink& sink = context.GetOutput();
         ObjectHolder result;
         bool first = true;
         for (const auto& st : statements_) {
             if (!first) {
-                os << ' ';
+                sink.Write(' ');
             }
             first = false;
 
             result = st->Execute(closure, context);
-            if (!result.Get()) {
-                os << "None"s;
-            }
-            else {
-                result.Get()->Print(os, context);
+            //    Write,       ;
+            //         
+            switch (result.GetTypeTag()) {
+            case runtime::TypeTag::NONE:
+                sink.Write("None"sv);
+                break;
+            case runtime::TypeTag::STRING:
+                sink.Write(static_cast<runtime::String&>(*result).GetValue());
+                break;
+            default:
+                result->AppendTo(sink.GetBuffer(), context);
             }
         }
-        os << '\n';
+        sink.Write('\n');
+        sink.Commit();
         return result;
     }
 
@@ -99,114 +194,347 @@ namespace ast {
         , args_(move(args))
     {}
 
+    const runtime::Method* MethodCall::ResolveMethod(const runtime::ClassInstance& obj) {
+        const runtime::Method* method = cache_.Lookup(obj.GetClass(), method_);
+        if (!method || method->formal_params.size() != args_.size()) {
+            throw runtime_error("Method "s + method_ + " not found"s);
+        }
+        return method;
+    }
+
+    ObjectHolder MethodCall::CallBuiltinMethod(ObjectHolder& obj, Closure& closure, Context& context) {
+        const runtime::TypeTag tag = obj.GetTypeTag();
+        if (tag != runtime::TypeTag::LIST && tag != runtime::TypeTag::DICT && tag != runtime::TypeTag::STRING) {
+            throw runtime_error("Method "s + method_ + " called on a non-object value"s);
+        }
+        vector<ObjectHolder> args;
+        args.reserve(args_.size());
+        for (const auto& arg : args_) {
+            args.push_back(arg->Execute(closure, context));
+        }
+        switch (tag) {
+        case runtime::TypeTag::DICT:
+            return static_cast<runtime::Dict&>(*obj).CallMethod(method_, args, context);
+        case runtime::TypeTag::STRING:
+            return runtime::CallStringMethod(static_cast<runtime::String&>(*obj).GetValue(), method_, args);
+        default:
+            return static_cast<runtime::List&>(*obj).CallMethod(method_, args);
+        }
+    }
+
     ObjectHolder MethodCall::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
         ObjectHolder obj = object_->Execute(closure, context);
-        runtime::ClassInstance* cls_inst_ptr = obj.TryAs<runtime::ClassInstance>();
+        if (obj.GetTypeTag() != runtime::TypeTag::INSTANCE) {
+            return CallBuiltinMethod(obj, closure, context);
+        }
+        auto& cls_inst = static_cast<runtime::ClassInstance&>(*obj);
+        const runtime::Method* method = ResolveMethod(cls_inst);
 
-        vector<ObjectHolder> actual_args;
-        for (const auto& arg : args_) {
-            actual_args.push_back(move(arg->Execute(closure, context)));
+        runtime::CallStack::Frame frame(context.GetCallStack());
+        frame->emplace(SELF, std::move(obj));
+        for (size_t i = 0; i < args_.size(); ++i) {
+            (*frame)[method->formal_params[i]] = args_[i]->Execute(closure, context);
         }
 
-        return cls_inst_ptr->Call(method_, actual_args, context);
+        return cls_inst.CallInFrame(*method, *frame, context);
+    }
+
+    void MethodCall::PrepareTailCall(Closure& closure, Context& context) {
+        ObjectHolder obj = object_->Execute(closure, context);
+        //     ,     
+        if (obj.GetTypeTag() != runtime::TypeTag::INSTANCE) {
+            context.SetReturn(CallBuiltinMethod(obj, closure, context));
+            return;
+        }
+        const runtime::Method* method = ResolveMethod(static_cast<runtime::ClassInstance&>(*obj));
+
+        //     ,     .
+        //           
+        vector<ObjectHolder>& args = context.GetTailCallArgs();
+        const size_t base = args.size();
+        try {
+            for (const auto& arg : args_) {
+                ObjectHolder value = arg->Execute(closure, context);
+                args.push_back(std::move(value));
+            }
+        }
+        catch (...) {
+            args.resize(base);
+            throw;
+        }
+        context.SetTailCall(std::move(obj), *method);
+    }
+
+    const runtime::InlineCache& MethodCall::GetCache() const {
+        return cache_;
     }
 
     ObjectHolder Stringify::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
         ObjectHolder obj = arg_->Execute(closure, context);
         if (!obj) {
             return ObjectHolder::Own(runtime::String{ "None"s });
         }
 
-        stringstream ss;
-        runtime::SimpleContext ctx(ss);
+        //      :    
+        //    (    String)
+        std::string text;
+        obj->AppendTo(text, context);
+        return ObjectHolder::Own(runtime::String{ std::move(text) });
+    }
+
+    BuiltinCall::BuiltinCall(const runtime::Builtin& builtin, std::vector<std::unique_ptr<Statement>> args)
+        : builtin_(builtin)
+        , args_(move(args))
+    {}
 
-        obj->Print(ss, context);
-        return ObjectHolder::Own(runtime::String{ ss.str() });
+    ObjectHolder BuiltinCall::Execute(Closure& closure, Context& context) {
+        vector<ObjectHolder> args;
+        args.reserve(args_.size());
+        for (const auto& arg : args_) {
+            args.push_back(arg->Execute(closure, context));
+        }
+        return builtin_.function(args, context);
     }
 
-    ObjectHolder Add::Execute(Closure& closure, Context& context) {
-        ObjectHolder lhs = lhs_->Execute(closure, context);
-        ObjectHolder rhs = rhs_->Execute(closure, context);
+    ListLiteral::ListLiteral(std::vector<std::unique_ptr<Statement>> items)
+        : items_(move(items))
+    {}
 
-        runtime::Number* lhs_num = lhs.TryAs<runtime::Number>();
-        runtime::String* lhs_string = lhs.TryAs<runtime::String>();
-        runtime::ClassInstance* lhs_cls_inst = lhs.TryAs<runtime::ClassInstance>();
+    ObjectHolder ListLiteral::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
+        runtime::CycleCollector::Current().MaybeCollect();
+        vector<ObjectHolder> items;
+        items.reserve(items_.size());
+        for (const auto& item : items_) {
+            items.push_back(item->Execute(closure, context));
+        }
+        return ObjectHolder::Own(runtime::List(move(items)));
+    }
 
-        if (lhs_num) {
-            runtime::Number* rhs_num = rhs.TryAs<runtime::Number>();
-            if (!rhs_num) {
-                throw runtime_error("Can't Add different types"s);
+    Index::Index(std::unique_ptr<Statement> object, std::unique_ptr<Statement> index)
+        : object_(move(object))
+        , index_(move(index))
+    {}
+
+    DictLiteral::DictLiteral(std::vector<Item> items)
+        : items_(move(items))
+    {}
+
+    ObjectHolder DictLiteral::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
+        runtime::CycleCollector::Current().MaybeCollect();
+        ObjectHolder result = ObjectHolder::Own(runtime::Dict{});
+        auto& dict = static_cast<runtime::Dict&>(*result);
+        for (const auto& [key, value] : items_) {
+            ObjectHolder key_value = key->Execute(closure, context);
+            dict.Set(std::move(key_value), value->Execute(closure, context), context);
+        }
+        return result;
+    }
+
+    ObjectHolder Index::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
+        ObjectHolder obj = object_->Execute(closure, context);
+        ObjectHolder index = index_->Execute(closure, context);
+        switch (obj.GetTypeTag()) {
+        case runtime::TypeTag::LIST:
+            return static_cast<runtime::List&>(*obj).At(runtime::ToIndex(index));
+        case runtime::TypeTag::DICT:
+            return static_cast<runtime::Dict&>(*obj).At(index, context);
+        case runtime::TypeTag::STRING: {
+            const string& str = static_cast<runtime::String&>(*obj).GetValue();
+            int64_t position = runtime::ToIndex(index);
+            if (position < 0) {
+                position += static_cast<int64_t>(str.size());
             }
-            return ObjectHolder::Own(runtime::Number{ lhs_num->GetValue() + rhs_num->GetValue() });
+            if (position < 0 || position >= static_cast<int64_t>(str.size())) {
+                throw runtime_error("String index out of range"s);
+            }
+            return ObjectHolder::Own(runtime::String{ string(1, str[static_cast<size_t>(position)]) });
+        }
+        case runtime::TypeTag::RANGE:
+            return ObjectHolder::Own(runtime::Number{ static_cast<runtime::Range&>(*obj).At(runtime::ToIndex(index)) });
+        default:
+            throw runtime_error("Object is not subscriptable"s);
         }
-        else if (lhs_string) {
-            runtime::String* rhs_string = rhs.TryAs<runtime::String>();
-            if (!rhs_string) {
-                throw runtime_error("Can't Add different types"s);
+    }
+
+    Slice::Slice(std::unique_ptr<Statement> object, std::unique_ptr<Statement> start, std::unique_ptr<Statement> stop)
+        : object_(move(object))
+        , start_(move(start))
+        , stop_(move(stop))
+    {}
+
+    ObjectHolder Slice::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
+        ObjectHolder obj = object_->Execute(closure, context);
+        const ObjectHolder start = start_ ? start_->Execute(closure, context) : ObjectHolder::None();
+        const ObjectHolder stop = stop_ ? stop_->Execute(closure, context) : ObjectHolder::None();
+        switch (obj.GetTypeTag()) {
+        case runtime::TypeTag::STRING: {
+            const string& str = static_cast<runtime::String&>(*obj).GetValue();
+            const auto [begin, end] = runtime::SliceBounds(start, stop, str.size());
+            if (begin == 0 && end == str.size()) {
+                return obj;
             }
-            return ObjectHolder::Own(runtime::String{ string(lhs_string->GetValue()) + string(rhs_string->GetValue()) });
+            return ObjectHolder::Own(runtime::String{ str.substr(begin, end - begin) });
         }
-        else if (lhs_cls_inst) {
-            return lhs_cls_inst->Call(ADD_METHOD, { rhs_->Execute(closure, context) }, context);
+        case runtime::TypeTag::LIST: {
+            const auto& items = static_cast<runtime::List&>(*obj).GetItems();
+            const auto [begin, end] = runtime::SliceBounds(start, stop, items.size());
+            return ObjectHolder::Own(runtime::List({ items.begin() + static_cast<ptrdiff_t>(begin),
+                                                     items.begin() + static_cast<ptrdiff_t>(end) }));
         }
+        default:
+            throw runtime_error("Object is not sliceable"s);
+        }
+    }
 
-        throw runtime_error("Addition error"s);
+    IndexAssignment::IndexAssignment(std::unique_ptr<Statement> object, std::unique_ptr<Statement> index,
+        std::unique_ptr<Statement> rv)
+        : object_(move(object))
+        , index_(move(index))
+        , rv_(move(rv))
+    {}
+
+    ObjectHolder IndexAssignment::Execute(Closure& closure, Context& context) {
+        //    Python,   :  rv    
+        ObjectHolder value = rv_->Execute(closure, context);
+        ObjectHolder obj = object_->Execute(closure, context);
+        ObjectHolder index = index_->Execute(closure, context);
+        switch (obj.GetTypeTag()) {
+        case runtime::TypeTag::LIST: {
+            ObjectHolder& item = static_cast<runtime::List&>(*obj).At(runtime::ToIndex(index));
+            item = std::move(value);
+            return item;
+        }
+        case runtime::TypeTag::DICT:
+            return static_cast<runtime::Dict&>(*obj).Set(std::move(index), std::move(value), context);
+        default:
+            throw runtime_error("Object does not support item assignment"s);
+        }
     }
 
-    ObjectHolder Sub::Execute(Closure& closure, Context& context) {
-        ObjectHolder lhs = lhs_->Execute(closure, context);
-        ObjectHolder rhs = rhs_->Execute(closure, context);
+    ArithmeticDispatcher::ArithmeticDispatcher(ArithmeticOperation op)
+        : op_(op)
+    {}
+
+    ObjectHolder ArithmeticDispatcher::Apply(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
+        const runtime::TypeTag lhs_tag = lhs.GetTypeTag();
+        const runtime::TypeTag rhs_tag = rhs.GetTypeTag();
 
-        runtime::Number* lhs_num = lhs.TryAs<runtime::Number>();
-        runtime::Number* rhs_num = rhs.TryAs<runtime::Number>();
-        if (!lhs_num || !rhs_num) {
-            throw runtime_error("Only numbers can be substracted"s);
+        if (lhs_tag == runtime::TypeTag::NUMBER && rhs_tag == runtime::TypeTag::NUMBER) {
+            const int64_t a = static_cast<const runtime::Number&>(*lhs).GetValue();
+            const int64_t b = static_cast<const runtime::Number&>(*rhs).GetValue();
+            int64_t result;
+            if (!CheckedOperation(op_, a, b, &result)) {
+                return ObjectHolder::Own(runtime::Number{ result });
+            }
+            return IntegerSlowPath(op_)(lhs, rhs);
+        }
+        if (runtime::IsInteger(lhs) && runtime::IsInteger(rhs)) {
+            return IntegerSlowPath(op_)(lhs, rhs);
+        }
+        if (op_ == ArithmeticOperation::ADD && lhs_tag == runtime::TypeTag::STRING
+            && rhs_tag == runtime::TypeTag::STRING) {
+            const string& lhs_str = static_cast<const runtime::String&>(*lhs).GetValue();
+            const string& rhs_str = static_cast<const runtime::String&>(*rhs).GetValue();
+            string result;
+            result.reserve(lhs_str.size() + rhs_str.size());
+            result.append(lhs_str).append(rhs_str);
+            return ObjectHolder::Own(runtime::String{ move(result) });
         }
 
-        return ObjectHolder::Own(runtime::Number{ lhs_num->GetValue() - rhs_num->GetValue() });
+        const OperatorMethods& methods = GetOperatorMethods(op_);
+        if (lhs_tag == runtime::TypeTag::INSTANCE) {
+            auto& cls_inst = static_cast<runtime::ClassInstance&>(*lhs);
+            const runtime::Method* method = cache_.Lookup(cls_inst.GetClass(), methods.direct);
+            if (method && method->formal_params.size() == 1) {
+                return cls_inst.Call(*method, { rhs }, context);
+            }
+        }
+        if (rhs_tag == runtime::TypeTag::INSTANCE) {
+            auto& cls_inst = static_cast<runtime::ClassInstance&>(*rhs);
+            const runtime::Method* method = reflected_cache_.Lookup(cls_inst.GetClass(), methods.reflected);
+            if (method && method->formal_params.size() == 1) {
+                return cls_inst.Call(*method, { lhs }, context);
+            }
+        }
+        throw runtime_error(methods.error);
     }
 
-    ObjectHolder Mult::Execute(Closure& closure, Context& context) {
-        ObjectHolder lhs = lhs_->Execute(closure, context);
-        ObjectHolder rhs = rhs_->Execute(closure, context);
+    ArithmeticOperation ArithmeticDispatcher::GetOperation() const {
+        return op_;
+    }
 
-        runtime::Number* lhs_num = lhs.TryAs<runtime::Number>();
-        runtime::Number* rhs_num = rhs.TryAs<runtime::Number>();
-        if (!lhs_num || !rhs_num) {
-            throw runtime_error("Only numbers can be multiplied"s);
-        }
+    const runtime::InlineCache& ArithmeticDispatcher::GetCache() const {
+        return cache_;
+    }
 
-        return ObjectHolder::Own(runtime::Number{ lhs_num->GetValue() * rhs_num->GetValue() });
+    const runtime::InlineCache& ArithmeticDispatcher::GetReflectedCache() const {
+        return reflected_cache_;
     }
 
-    ObjectHolder Div::Execute(Closure& closure, Context& context) {
+    ArithmeticBinaryOperation::ArithmeticBinaryOperation(ArithmeticOperation op, std::unique_ptr<Statement> lhs,
+        std::unique_ptr<Statement> rhs)
+        : BinaryOperation(move(lhs), move(rhs))
+        , dispatcher_(op)
+    {}
+
+    ObjectHolder ArithmeticBinaryOperation::Execute(Closure& closure, Context& context) {
+        //    a + b + ... ,       
+        runtime::CheckNativeStack();
         ObjectHolder lhs = lhs_->Execute(closure, context);
         ObjectHolder rhs = rhs_->Execute(closure, context);
+        return dispatcher_.Apply(lhs, rhs, context);
+    }
 
-        runtime::Number* lhs_num = lhs.TryAs<runtime::Number>();
-        runtime::Number* rhs_num = rhs.TryAs<runtime::Number>();
-        if (!lhs_num || !rhs_num) {
-            throw runtime_error("Only numbers can be divided"s);
-        }
-        if (rhs_num->GetValue() == 0) {
-            throw runtime_error("Zero division"s);
-        }
-
-        return ObjectHolder::Own(runtime::Number{ lhs_num->GetValue() / rhs_num->GetValue() });
+    const runtime::InlineCache& ArithmeticBinaryOperation::GetCache() const {
+        return dispatcher_.GetCache();
     }
 
+    Add::Add(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs)
+        : ArithmeticBinaryOperation(ArithmeticOperation::ADD, move(lhs), move(rhs))
+    {}
+
+    Sub::Sub(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs)
+        : ArithmeticBinaryOperation(ArithmeticOperation::SUB, move(lhs), move(rhs))
+    {}
+
+    Mult::Mult(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs)
+        : ArithmeticBinaryOperation(ArithmeticOperation::MULT, move(lhs), move(rhs))
+    {}
+
+    Div::Div(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs)
+        : ArithmeticBinaryOperation(ArithmeticOperation::DIV, move(lhs), move(rhs))
+    {}
+
     ObjectHolder Compound::Execute(Closure& closure, Context& context) {
         for (const auto& stmt : statements_) {
             stmt->Execute(closure, context);
+            if (context.GetCompletion() != runtime::Completion::NORMAL) {
+                break;
+            }
         }
         return {};
     }
 
-    ObjectHolder Return::Execute(Closure& closure, Context& context) { // TODO
+    Return::Return(std::unique_ptr<Statement> statement)
+        : statement_(std::move(statement))
+        , tail_call_(dynamic_cast<MethodCall*>(statement_.get()))
+    {}
+
+    ObjectHolder Return::Execute(Closure& closure, Context& context) {
+        //      ,     
+        if (tail_call_ && context.GetCallStack().GetDepth() > 0) {
+            tail_call_->PrepareTailCall(closure, context);
+            return {};
+        }
         ObjectHolder res = statement_->Execute(closure, context);
-        closure["return"s] = res;
-        throw runtime_error("executing return statement"s);
-        return {};
+        context.SetReturn(res);
+        return res;
     }
 
     ClassDefinition::ClassDefinition(ObjectHolder cls)
@@ -227,10 +555,108 @@ namespace ast {
 
     ObjectHolder FieldAssignment::Execute(Closure& closure, Context& context) {
         ObjectHolder obj_holder = obj_.Execute(closure, context);
-        runtime::ClassInstance* cls_inst = obj_holder.TryAs<runtime::ClassInstance>();
+        if (obj_holder.GetTypeTag() != runtime::TypeTag::INSTANCE) {
+            throw runtime_error("Only class instances have fields"s);
+        }
+        auto& cls_inst = static_cast<runtime::ClassInstance&>(*obj_holder);
         ObjectHolder rv_res = rv_->Execute(closure, context);
-        cls_inst->Fields()[field_name_] = rv_res;
-        return cls_inst->Fields()[field_name_];
+        //     rv:        
+        if (ObjectHolder* field = cache_.Find(cls_inst, field_name_)) {
+            *field = std::move(rv_res);
+            return *field;
+        }
+        return cls_inst.SetField(field_name_, std::move(rv_res));
+    }
+
+    AugmentedAssignment::AugmentedAssignment(std::string var, Operation op, std::unique_ptr<Statement> rv)
+        : name_(move(var))
+        , rv_(move(rv))
+        , dispatcher_(op)
+    {}
+
+    AugmentedAssignment::AugmentedAssignment(VariableValue object, std::string field_name, Operation op,
+        std::unique_ptr<Statement> rv)
+        : object_(make_unique<VariableValue>(move(object)))
+        , name_(move(field_name))
+        , rv_(move(rv))
+        , dispatcher_(op)
+    {}
+
+    ObjectHolder AugmentedAssignment::Execute(Closure& closure, Context& context) {
+        if (!object_) {
+            //       closure,    
+            auto it = closure.find(name_);
+            if (it == closure.end()) {
+                throw runtime_error("Variable error"s);
+            }
+            ObjectHolder rhs = rv_->Execute(closure, context);
+            if (!TryUpdateInPlace(it->second, rhs)) {
+                it->second = Combine(it->second, rhs, context);
+            }
+            return it->second;
+        }
+
+        ObjectHolder obj_holder = object_->Execute(closure, context);
+        if (obj_holder.GetTypeTag() != runtime::TypeTag::INSTANCE) {
+            throw runtime_error("Only class instances have fields"s);
+        }
+        auto* cls_inst = static_cast<runtime::ClassInstance*>(obj_holder.Get());
+        const ObjectHolder* field = field_cache_.Find(*cls_inst, name_);
+        ObjectHolder old_value = field ? *field : ObjectHolder::None();
+        //  rhs   ,       
+        ObjectHolder rhs = rv_->Execute(closure, context);
+
+        ObjectHolder* slot = field_cache_.Find(*cls_inst, name_);
+        if (slot && old_value && slot->Get() == old_value.Get()) {
+            //  -   :   ,       
+            old_value = ObjectHolder::None();
+            if (TryUpdateInPlace(*slot, rhs)) {
+                return *slot;
+            }
+            old_value = *slot;
+        }
+        //  __iadd__    ,  slot    
+        return cls_inst->SetField(name_, Combine(old_value, rhs, context));
+    }
+
+    bool AugmentedAssignment::TryUpdateInPlace(ObjectHolder& target, const ObjectHolder& rhs) const {
+        if (!target.IsUnique()) {
+            return false;
+        }
+        runtime::TypeTag target_tag = target.GetTypeTag();
+        runtime::TypeTag rhs_tag = rhs.GetTypeTag();
+
+        if (target_tag == runtime::TypeTag::NUMBER && rhs_tag == runtime::TypeTag::NUMBER) {
+            int64_t& value = static_cast<runtime::Number&>(*target).GetMutableValue();
+            int64_t rhs_value = static_cast<const runtime::Number&>(*rhs).GetValue();
+            //       ,
+            //        
+            int64_t result = 0;
+            const bool overflow = CheckedOperation(dispatcher_.GetOperation(), value, rhs_value, &result);
+            if (overflow) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+        if (dispatcher_.GetOperation() == Operation::ADD && target_tag == runtime::TypeTag::STRING
+            && rhs_tag == runtime::TypeTag::STRING) {
+            static_cast<runtime::String&>(*target).GetMutableValue() +=
+                static_cast<const runtime::String&>(*rhs).GetValue();
+            return true;
+        }
+        return false;
+    }
+
+    ObjectHolder AugmentedAssignment::Combine(const ObjectHolder& lhs, const ObjectHolder& rhs, Context& context) {
+        if (dispatcher_.GetOperation() == Operation::ADD && lhs.GetTypeTag() == runtime::TypeTag::INSTANCE) {
+            auto& cls_inst = static_cast<runtime::ClassInstance&>(*lhs);
+            const runtime::Method* method = iadd_cache_.Lookup(cls_inst.GetClass(), IADD_METHOD);
+            if (method && method->formal_params.size() == 1) {
+                return cls_inst.Call(*method, { rhs }, context);
+            }
+        }
+        return dispatcher_.Apply(lhs, rhs, context);
     }
 
     IfElse::IfElse(std::unique_ptr<Statement> condition, std::unique_ptr<Statement> if_body,
@@ -241,7 +667,7 @@ namespace ast {
     {}
 
     ObjectHolder IfElse::Execute(Closure& closure, Context& context) {
-        if (runtime::IsTrue(cond_->Execute(closure, context))) {
+        if (runtime::IsTrue(cond_->Execute(closure, context), context)) {
             return if_->Execute(closure, context);
         }
         else if (else_.get()) {
@@ -250,22 +676,97 @@ namespace ast {
         return {};
     }
 
+    While::While(std::unique_ptr<Statement> condition, std::unique_ptr<Statement> body)
+        : cond_(move(condition))
+        , body_(move(body))
+    {}
+
+    ObjectHolder While::Execute(Closure& closure, Context& context) {
+        while (runtime::IsTrue(cond_->Execute(closure, context), context)) {
+            body_->Execute(closure, context);
+            const runtime::Completion completion = context.GetCompletion();
+            if (completion == runtime::Completion::BREAK) {
+                context.SetCompletion(runtime::Completion::NORMAL);
+                break;
+            }
+            if (completion == runtime::Completion::CONTINUE) {
+                context.SetCompletion(runtime::Completion::NORMAL);
+            }
+            else if (completion != runtime::Completion::NORMAL) {
+                break;
+            }
+        }
+        return {};
+    }
+
+    ForLoop::ForLoop(std::string var, std::unique_ptr<Statement> iterable, std::unique_ptr<Statement> body)
+        : var_(move(var))
+        , iterable_(move(iterable))
+        , body_(move(body))
+    {}
+
+    ObjectHolder ForLoop::Execute(Closure& closure, Context& context) {
+        ObjectHolder iterable = iterable_->Execute(closure, context);
+        auto iterator = runtime::MakeIterator(iterable, context);
+
+        //           closure,
+        //        
+        size_t position = 0;
+        //    :      ,
+        //     .      ,  
+        ObjectHolder item;
+        while (iterator->Next(item, context)) {
+            ObjectHolder* slot = closure.FindWithHint(var_, position);
+            if (!slot) {
+                slot = &closure.emplace(var_, ObjectHolder::None()).first->second;
+            }
+            std::swap(*slot, item);
+
+            body_->Execute(closure, context);
+            const runtime::Completion completion = context.GetCompletion();
+            if (completion == runtime::Completion::BREAK) {
+                context.SetCompletion(runtime::Completion::NORMAL);
+                break;
+            }
+            if (completion == runtime::Completion::CONTINUE) {
+                context.SetCompletion(runtime::Completion::NORMAL);
+            }
+            else if (completion != runtime::Completion::NORMAL) {
+                break;
+            }
+        }
+        return {};
+    }
+
+    ObjectHolder Break::Execute([[maybe_unused]] Closure& closure, Context& context) {
+        context.SetCompletion(runtime::Completion::BREAK);
+        return {};
+    }
+
+    ObjectHolder Continue::Execute([[maybe_unused]] Closure& closure, Context& context) {
+        context.SetCompletion(runtime::Completion::CONTINUE);
+        return {};
+    }
+
     ObjectHolder Or::Execute(Closure& closure, Context& context) {
-        if (!runtime::IsTrue(lhs_->Execute(closure, context))) {
-            return ObjectHolder::Own(runtime::Bool{ runtime::IsTrue(rhs_->Execute(closure, context)) });
+        runtime::CheckNativeStack();
+        if (!runtime::IsTrue(lhs_->Execute(closure, context), context)) {
+            return runtime::MakeBool(runtime::IsTrue(rhs_->Execute(closure, context), context));
         }
-        return ObjectHolder::Own(runtime::Bool{ true });
+        return runtime::MakeBool(true);
     }
 
     ObjectHolder And::Execute(Closure& closure, Context& context) {
-        if (runtime::IsTrue(lhs_->Execute(closure, context))) {
-            return ObjectHolder::Own(runtime::Bool{ runtime::IsTrue(rhs_->Execute(closure, context)) });
+        runtime::CheckNativeStack();
+        if (runtime::IsTrue(lhs_->Execute(closure, context), context)) {
+            return runtime::MakeBool(runtime::IsTrue(rhs_->Execute(closure, context), context));
         }
-        return ObjectHolder::Own(runtime::Bool{ false });
+        return runtime::MakeBool(false);
     }
 
     ObjectHolder Not::Execute(Closure& closure, Context& context) {
-        return ObjectHolder::Own(runtime::Bool{ !IsTrue(arg_->Execute(closure, context)) });
+        runtime::CheckNativeStack();
+        return runtime::MakeBool(!runtime::IsTrue(arg_->Execute(closure, context), context));
     }
 
     Comparison::Comparison(Comparator cmp, unique_ptr<Statement> lhs, unique_ptr<Statement> rhs)
@@ -274,9 +775,10 @@ namespace ast {
     {}
 
     ObjectHolder Comparison::Execute(Closure& closure, Context& context) {
+        runtime::CheckNativeStack();
         ObjectHolder lhs_res = lhs_->Execute(closure, context);
         ObjectHolder rhs_res = rhs_->Execute(closure, context);
-        return ObjectHolder::Own(runtime::Bool{ cmp_(lhs_res, rhs_res, context) });
+        return runtime::MakeBool(cmp_(lhs_res, rhs_res, context));
     }
 
     NewInstance::NewInstance(const runtime::Class& class_, std::vector<std::unique_ptr<Statement>> args)
@@ -290,37 +792,35 @@ namespace ast {
     {}
 
     ObjectHolder NewInstance::Execute(Closure& closure, Context& context) {
+        runtime::CycleCollector::Current().MaybeCollect();
         ObjectHolder cls_inst_OH = ObjectHolder::Own(runtime::ClassInstance(cls_));
         runtime::ClassInstance* cls_inst_ptr_ = cls_inst_OH.TryAs<runtime::ClassInstance>();
-        if (cls_inst_ptr_->HasMethod(INIT_METHOD, args_.size())) {
-            vector<ObjectHolder> actual_args;
-            for (const auto& stmt : args_) {
-                actual_args.push_back(stmt->Execute(closure, context));
+        const runtime::Method* init = cache_.Lookup(cls_, INIT_METHOD);
+        if (init && init->formal_params.size() == args_.size()) {
+            runtime::CallStack::Frame frame(context.GetCallStack());
+            frame->emplace(SELF, cls_inst_OH);
+            for (size_t i = 0; i < args_.size(); ++i) {
+                (*frame)[init->formal_params[i]] = args_[i]->Execute(closure, context);
             }
-            cls_inst_ptr_->Call(INIT_METHOD, actual_args, context);
+            cls_inst_ptr_->CallInFrame(*init, *frame, context);
         }
         return cls_inst_OH;
     }
 
+    const runtime::InlineCache& NewInstance::GetCache() const {
+        return cache_;
+    }
+
     MethodBody::MethodBody(std::unique_ptr<Statement>&& body) 
         : body_(move(body))
     {}
 
     ObjectHolder MethodBody::Execute(Closure& closure, Context& context) {
-        try {
-            ObjectHolder res = body_->Execute(closure, context);
-            return {};
-        }
-        catch (const runtime_error& e) {
-            if (string(e.what()) == "executing return statement"s) {
-                ObjectHolder value_to_ret = closure.at("return"s);
-                closure.erase("return"s);
-                return value_to_ret;
-            }
-            else {
-                throw;
-            }
+        body_->Execute(closure, context);
+        if (context.GetCompletion() == runtime::Completion::RETURN) {
+            return context.TakeReturnValue();
         }
+        return {};
     }
 
 }  // namespace ast
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "bigint.h"
+#include "builtins.h"
 #include "runtime.h"
 
 #include <functional>
@@ -8,25 +10,55 @@ namespace ast {
 
     using Statement = runtime::Executable;
 
-    // ,    T,
-    //      
+    //       (. ValueStatement)
+    uint64_t NextConstantSerial();
+
+    /*
+     * ,    T,
+     *      .
+     *
+     *      ,     
+     *   :         .
+     *            index
+     * (. Context::GetConstantSlot)    .   , 
+     *  ObjectHolder     (. ObjectHolder::IsUnique)
+     *       .    :
+     *   True  False    
+     */
     template <typename T>
     class ValueStatement : public Statement {
     public:
-        explicit ValueStatement(T v)
-            : value_(std::move(v)) {
+        // index -    ,   .   
+        //   ,       
+        explicit ValueStatement(T v, size_t index = 0)
+            : value_(std::move(v))
+            , index_(index)
+            , serial_(NextConstantSerial()) {
         }
 
         runtime::ObjectHolder Execute(runtime::Closure& /*closure*/,
-            runtime::Context& /*context*/) override {
-            return runtime::ObjectHolder::Share(value_);
+            runtime::Context& context) override {
+            if constexpr (std::is_same_v<T, runtime::Bool>) {
+                return runtime::MakeBool(value_.GetValue());
+            }
+            else {
+                runtime::ConstantSlot& slot = context.GetConstantSlot(index_);
+                if (slot.serial != serial_) {
+                    slot.serial = serial_;
+                    slot.value = runtime::ObjectHolder::Own(T(value_));
+                }
+                return slot.value;
+            }
         }
 
     private:
-        T value_;
+        const T value_;
+        size_t index_;
+        uint64_t serial_;
     };
 
     using NumericConst = ValueStatement<runtime::Number>;
+    using BigNumericConst = ValueStatement<runtime::BigNumber>;
     using StringConst = ValueStatement<runtime::String>;
     using BoolConst = ValueStatement<runtime::Bool>;
 
@@ -34,17 +66,23 @@ namespace ast {
             id1.id2.id3.
     ,  circle.center.x -      :
     x = circle.center.x
+       ,    .  
+          ,      closure 
     */
     class VariableValue : public Statement {
     public:
         explicit VariableValue(const std::string& var_name);
         explicit VariableValue(std::vector<std::string> dotted_ids);
 
+        //         -   ,
+        //  runtime_error.      None
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
 
     private:
-        std::string var_name_;
         std::vector<std::string> dotted_ids_;
+        runtime::ClosureHint root_hint_;
+        // field_caches_[i]     dotted_ids_[i + 1]
+        std::vector<runtime::FieldCache> field_caches_;
     };
 
     //  ,      var,   rv
@@ -70,6 +108,82 @@ namespace ast {
         VariableValue obj_;
         std::string field_name_;
         std::unique_ptr<Statement> rv_;
+        runtime::FieldCache cache_;
+    };
+
+    //  
+    enum class ArithmeticOperation {
+        ADD,   // +,  __add__  __radd__
+        SUB,   // -,  __sub__  __rsub__
+        MULT,  // *,  __mul__  __rmul__
+        DIV,   // /,  __truediv__  __rtruediv__
+    };
+
+    /*
+          .   
+    Add, Sub, Mult, Div   ,       .
+        :
+     -  op :  int64    ,   -  
+     -  + 
+     -  op x:    ,  __add__(x)
+     - x op :    ,  __radd__(x),   x   
+           -.     runtime_error
+    */
+    class ArithmeticDispatcher {
+    public:
+        explicit ArithmeticDispatcher(ArithmeticOperation op);
+
+        runtime::ObjectHolder Apply(const runtime::ObjectHolder& lhs, const runtime::ObjectHolder& rhs,
+            runtime::Context& context);
+
+        [[nodiscard]] ArithmeticOperation GetOperation() const;
+
+        //  -      
+        [[nodiscard]] const runtime::InlineCache& GetCache() const;
+        //  -      
+        [[nodiscard]] const runtime::InlineCache& GetReflectedCache() const;
+
+    private:
+        ArithmeticOperation op_;
+        runtime::InlineCache cache_;
+        runtime::InlineCache reflected_cache_;
+    };
+
+    /*
+      target op= rv,  op -   +, -, *, /,  target - 
+       object.field_name.       .
+       - Number  String,     ,  
+          .    +=   __iadd__(rhs),
+           target op rv (. ArithmeticDispatcher);
+      
+    */
+    class AugmentedAssignment : public Statement {
+    public:
+        using Operation = ArithmeticOperation;
+
+        //    var
+        AugmentedAssignment(std::string var, Operation op, std::unique_ptr<Statement> rv);
+        //    object.field_name
+        AugmentedAssignment(VariableValue object, std::string field_name, Operation op,
+            std::unique_ptr<Statement> rv);
+
+        //    .      
+        //    ,  runtime_error
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        //      target Number  String.  false,   
+        bool TryUpdateInPlace(runtime::ObjectHolder& target, const runtime::ObjectHolder& rhs) const;
+        //  lhs op rhs   
+        runtime::ObjectHolder Combine(const runtime::ObjectHolder& lhs, const runtime::ObjectHolder& rhs,
+            runtime::Context& context);
+
+        std::unique_ptr<VariableValue> object_;
+        std::string name_;
+        std::unique_ptr<Statement> rv_;
+        runtime::FieldCache field_cache_;
+        runtime::InlineCache iadd_cache_;
+        ArithmeticDispatcher dispatcher_;
     };
 
     //  None
@@ -92,8 +206,8 @@ namespace ast {
         //   print     name
         static std::unique_ptr<Print> Variable(const std::string& name);
 
-        //     print     ,  
-        // context.GetOutputStream()
+        //     print     context.GetOutput().
+        //    OutputSink::Commit
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
 
     private:
@@ -109,10 +223,25 @@ namespace ast {
 
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
 
+        //     ,    ,   
+        //      (. Context::SetTailCall)
+        void PrepareTailCall(runtime::Closure& closure, runtime::Context& context);
+
+        //  -   
+        [[nodiscard]] const runtime::InlineCache& GetCache() const;
+
     private:
+        //     obj,  runtime_error,    
+        const runtime::Method* ResolveMethod(const runtime::ClassInstance& obj);
+
+        //    ,     (, , )
+        runtime::ObjectHolder CallBuiltinMethod(runtime::ObjectHolder& obj, runtime::Closure& closure,
+                                                runtime::Context& context);
+
         std::unique_ptr<Statement> object_;
         std::string method_;
         std::vector<std::unique_ptr<Statement>> args_;
+        runtime::InlineCache cache_;
     };
 
     /*
@@ -135,9 +264,13 @@ namespace ast {
         //  ,    ClassInstance
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
 
+        //  -   __init__
+        [[nodiscard]] const runtime::InlineCache& GetCache() const;
+
     private:
         const runtime::Class& cls_;
         std::vector<std::unique_ptr<Statement>> args_;
+        runtime::InlineCache cache_;
     };
 
     //     
@@ -157,6 +290,20 @@ namespace ast {
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
     };
 
+    //   ,   BuiltinRegistry   
+    class BuiltinCall : public Statement {
+    public:
+        //       builtin.      
+        BuiltinCall(const runtime::Builtin& builtin, std::vector<std::unique_ptr<Statement>> args);
+
+        //      ,    
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        const runtime::Builtin& builtin_;
+        std::vector<std::unique_ptr<Statement>> args_;
+    };
+
     //       lhs  rhs
     class BinaryOperation : public Statement {
     public:
@@ -169,51 +316,62 @@ namespace ast {
         std::unique_ptr<Statement> rhs_;
     };
 
-    //    +   lhs  rhs
-    class Add : public BinaryOperation {
+    //   :  lhs  rhs       ArithmeticDispatcher
+    class ArithmeticBinaryOperation : public BinaryOperation {
     public:
-        using BinaryOperation::BinaryOperation;
+        ArithmeticBinaryOperation(ArithmeticOperation op, std::unique_ptr<Statement> lhs,
+            std::unique_ptr<Statement> rhs);
 
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+        //  -      
+        [[nodiscard]] const runtime::InlineCache& GetCache() const;
+
+    private:
+        ArithmeticDispatcher dispatcher_;
+    };
+
+    //    +   lhs  rhs
+    class Add : public ArithmeticBinaryOperation {
+    public:
         //  :
         //   + 
         //   + 
-        //  1 + 2,   1 -     _add__(rhs)
+        //  1 + 2,   1 -     __add__(rhs)
+        //  x + ,   x   __add__,      __radd__(lhs)
         //       runtime_error
-        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+        Add(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs);
     };
 
     //     lhs  rhs
-    class Sub : public BinaryOperation {
+    class Sub : public ArithmeticBinaryOperation {
     public:
-        using BinaryOperation::BinaryOperation;
-
         //  :
         //   - 
-        //  lhs  rhs -  ,   runtime_error
-        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+        //   - x  x -     __sub__(rhs)  __rsub__(lhs) 
+        //      runtime_error
+        Sub(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs);
     };
 
     //     lhs  rhs
-    class Mult : public BinaryOperation {
+    class Mult : public ArithmeticBinaryOperation {
     public:
-        using BinaryOperation::BinaryOperation;
-
         //  :
         //   * 
-        //  lhs  rhs -  ,   runtime_error
-        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+        //   * x  x *     __mul__(rhs)  __rmul__(lhs) 
+        //      runtime_error
+        Mult(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs);
     };
 
     //    lhs  rhs
-    class Div : public BinaryOperation {
+    class Div : public ArithmeticBinaryOperation {
     public:
-        using BinaryOperation::BinaryOperation;
-
         //  :
         //   / 
-        //  lhs  rhs -  ,   runtime_error
+        //   / x  x /     __truediv__(rhs)  __rtruediv__(lhs) 
         //  rhs  0,   runtime_error
-        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+        //      runtime_error
+        Div(std::unique_ptr<Statement> lhs, std::unique_ptr<Statement> rhs);
     };
 
     //      or  lhs  rhs
@@ -241,6 +399,74 @@ namespace ast {
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
     };
 
+    //      items: [item1, item2, ...]
+    class ListLiteral : public Statement {
+    public:
+        explicit ListLiteral(std::vector<std::unique_ptr<Statement>> items);
+
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::vector<std::unique_ptr<Statement>> items_;
+    };
+
+    //     : {key1: value1, key2: value2, ...}
+    class DictLiteral : public Statement {
+    public:
+        using Item = std::pair<std::unique_ptr<Statement>, std::unique_ptr<Statement>>;
+
+        explicit DictLiteral(std::vector<Item> items);
+
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::vector<Item> items_;
+    };
+
+    //      object[index]    object[index].
+    //        
+    class Index : public Statement {
+    public:
+        Index(std::unique_ptr<Statement> object, std::unique_ptr<Statement> index);
+
+        //  object -  ,     , index      
+        //    ,  runtime_error
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::unique_ptr<Statement> object_;
+        std::unique_ptr<Statement> index_;
+    };
+
+    //   object[start:stop]   .  start  stop   nullptr
+    class Slice : public Statement {
+    public:
+        Slice(std::unique_ptr<Statement> object, std::unique_ptr<Statement> start, std::unique_ptr<Statement> stop);
+
+        //     Python (. runtime::SliceBounds).
+        //  object -     ,  runtime_error
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::unique_ptr<Statement> object_;
+        std::unique_ptr<Statement> start_;
+        std::unique_ptr<Statement> stop_;
+    };
+
+    //      object[index]   rv
+    class IndexAssignment : public Statement {
+    public:
+        IndexAssignment(std::unique_ptr<Statement> object, std::unique_ptr<Statement> index,
+            std::unique_ptr<Statement> rv);
+
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::unique_ptr<Statement> object_;
+        std::unique_ptr<Statement> index_;
+        std::unique_ptr<Statement> rv_;
+    };
+
     //   (:  ,   if,  else)
     class Compound : public Statement {
     public:
@@ -281,16 +507,18 @@ namespace ast {
     //   return   statement
     class Return : public Statement {
     public:
-        explicit Return(std::unique_ptr<Statement> statement) 
-            : statement_(std::move(statement))
-        {}
+        explicit Return(std::unique_ptr<Statement> statement);
 
         //    .    return ,
         //     ,      statement.
+        //   :    context.SetReturn,  Compound
+        //    ,  Completion::RETURN.
+        //  statement -  ,     (Completion::TAIL_CALL)
         runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
 
     private:
         std::unique_ptr<Statement> statement_;
+        MethodCall* tail_call_;
     };
 
     //  
@@ -322,6 +550,52 @@ namespace ast {
         std::unique_ptr<Statement> else_;
     };
 
+    //  while <condition>: <body>.      
+    class While : public Statement {
+    public:
+        While(std::unique_ptr<Statement> condition, std::unique_ptr<Statement> body);
+
+        //  body,  condition . Completion::BREAK  ,
+        // Completion::CONTINUE    , RETURN  TAIL_CALL  
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::unique_ptr<Statement> cond_;
+        std::unique_ptr<Statement> body_;
+    };
+
+    /*
+     for <var> in <iterable>: <body>.      .
+       runtime::MakeIterator,    .
+         closure,   Number  String,  
+       ,   
+    */
+    class ForLoop : public Statement {
+    public:
+        ForLoop(std::string var, std::unique_ptr<Statement> iterable, std::unique_ptr<Statement> body);
+
+        // Completion::BREAK  , Completion::CONTINUE    ,
+        // RETURN  TAIL_CALL  .   ,    
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+
+    private:
+        std::string var_;
+        std::unique_ptr<Statement> iterable_;
+        std::unique_ptr<Statement> body_;
+    };
+
+    //  break
+    class Break : public Statement {
+    public:
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+    };
+
+    //  continue
+    class Continue : public Statement {
+    public:
+        runtime::ObjectHolder Execute(runtime::Closure& closure, runtime::Context& context) override;
+    };
+
     //  
     class Comparison : public BinaryOperation {
     public:
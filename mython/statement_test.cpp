@@ -1,6 +1,9 @@
+#include "bigint.h"
 #include "statement.h"
 #include "test_runner_p.h"
 
+#include <limits>
+
 using namespace std;
 
 namespace ast {
@@ -65,6 +68,29 @@ namespace ast {
             ASSERT(context.output.str().empty());
         }
 
+        void TestConstantsPerContext() {
+            runtime::DummyContext first;
+            runtime::DummyContext second;
+            Closure empty;
+
+            //         
+            StringConst text(runtime::String("text"s), 0);
+            ObjectHolder a = text.Execute(empty, first);
+            ASSERT(a.Get() == text.Execute(empty, first).Get());
+            ObjectHolder b = text.Execute(empty, second);
+            ASSERT(a.Get() != b.Get());
+            ASSERT(!a.IsUnique());
+
+            //           ,    
+            NumericConst number(runtime::Number(7), 0);
+            ASSERT_OBJECT_VALUE_EQUAL(number.Execute(empty, first), 7);
+            ASSERT_OBJECT_VALUE_EQUAL(text.Execute(empty, first), "text"s);
+            ASSERT_OBJECT_VALUE_EQUAL(a, "text"s);
+
+            BoolConst yes(runtime::Bool(true));
+            ASSERT(yes.Execute(empty, first).Get() == runtime::MakeBool(true).Get());
+        }
+
         void TestVariable() {
             runtime::DummyContext context;
 
@@ -226,6 +252,37 @@ namespace ast {
             ASSERT(context.output.str().empty());
         }
 
+        void TestIntegerOverflowPromotion() {
+            runtime::DummyContext context;
+            Closure empty;
+
+            const int64_t max = numeric_limits<int64_t>::max();
+            const int64_t min = numeric_limits<int64_t>::min();
+
+            ObjectHolder sum = Add(make_unique<NumericConst>(max), make_unique<NumericConst>(1)).Execute(empty, context);
+            ASSERT(sum.TryAs<runtime::BigNumber>() != nullptr);
+            ASSERT_EQUAL(sum.TryAs<runtime::BigNumber>()->GetValue().ToString(), "9223372036854775808"s);
+
+            ObjectHolder product = Mult(make_unique<NumericConst>(max), make_unique<NumericConst>(max)).Execute(empty, context);
+            ASSERT_EQUAL(product.TryAs<runtime::BigNumber>()->GetValue().ToString(),
+                         "85070591730234615847396907784232501249"s);
+
+            ObjectHolder quotient = Div(make_unique<NumericConst>(min), make_unique<NumericConst>(-1)).Execute(empty, context);
+            ASSERT_EQUAL(quotient.TryAs<runtime::BigNumber>()->GetValue().ToString(), "9223372036854775808"s);
+
+            // ,    int64,   Number
+            Closure closure;
+            closure.emplace("big"s, product);
+            ObjectHolder back = Div(make_unique<VariableValue>("big"s), make_unique<NumericConst>(max)).Execute(closure, context);
+            ASSERT_OBJECT_VALUE_EQUAL(back, max);
+
+            ObjectHolder diff = Sub(make_unique<NumericConst>(min), make_unique<NumericConst>(1)).Execute(empty, context);
+            ASSERT(diff.TryAs<runtime::BigNumber>() != nullptr);
+
+            ASSERT_THROWS(Div(make_unique<VariableValue>("big"s), make_unique<NumericConst>(0)).Execute(closure, context),
+                          runtime_error);
+        }
+
         void TestStringsAddition() {
             runtime::DummyContext context;
 
@@ -287,6 +344,59 @@ namespace ast {
             ASSERT(context.output.str().empty());
         }
 
+        // ,    
+        class CountingStatement : public Statement {
+        public:
+            CountingStatement(ObjectHolder value, int& counter)
+                : value_(move(value))
+                , counter_(counter)
+            {}
+
+            ObjectHolder Execute(Closure&, runtime::Context&) override {
+                ++counter_;
+                return value_;
+            }
+
+        private:
+            ObjectHolder value_;
+            int& counter_;
+        };
+
+        void TestOperatorOverloading() {
+            runtime::DummyContext context;
+            runtime::CacheCountingScope counting;
+
+            // __mul__   , __rsub__ -   
+            vector<runtime::Method> methods;
+            methods.push_back({ "__mul__"s, {"rhs"s}, make_unique<VariableValue>("rhs"s) });
+            methods.push_back({ "__rsub__"s, {"lhs"s},
+                                make_unique<Add>(make_unique<StringConst>("rsub "s), make_unique<Stringify>(
+                                    make_unique<VariableValue>("lhs"s))) });
+            runtime::Class cls("Vector"s, std::move(methods), nullptr);
+            ObjectHolder instance = ObjectHolder::Own(runtime::ClassInstance{ cls });
+
+            Closure empty;
+            int rhs_evaluations = 0;
+            Mult mult(make_unique<CountingStatement>(instance, rhs_evaluations),
+                      make_unique<CountingStatement>(ObjectHolder::Own(runtime::Number{ 3 }), rhs_evaluations));
+            ASSERT_OBJECT_VALUE_EQUAL(mult.Execute(empty, context), 3);
+            ASSERT_EQUAL(rhs_evaluations, 2);
+            ASSERT_OBJECT_VALUE_EQUAL(mult.Execute(empty, context), 3);
+            ASSERT_EQUAL(mult.GetCache().GetMisses(), 1U);
+            ASSERT_EQUAL(mult.GetCache().GetHits(), 1U);
+
+            //   ,       
+            Sub sub(make_unique<NumericConst>(10), make_unique<CountingStatement>(instance, rhs_evaluations));
+            ASSERT_OBJECT_VALUE_EQUAL(sub.Execute(empty, context), "rsub 10"s);
+            ASSERT_EQUAL(rhs_evaluations, 5);
+            ASSERT_THROWS(Sub(make_unique<CountingStatement>(instance, rhs_evaluations),
+                              make_unique<NumericConst>(1)).Execute(empty, context), std::runtime_error);
+            ASSERT_THROWS(Div(make_unique<NumericConst>(1), make_unique<CountingStatement>(instance, rhs_evaluations))
+                              .Execute(empty, context), std::runtime_error);
+            ASSERT_THROWS(Mult(make_unique<StringConst>("a"s), make_unique<NumericConst>(2)).Execute(empty, context),
+                          std::runtime_error);
+        }
+
         void TestCompound() {
             runtime::DummyContext context;
 
@@ -453,11 +563,80 @@ namespace ast {
             test_not(false);
         }
 
+        void TestReturnStopsMethodBody() {
+            runtime::DummyContext context;
+            Closure closure;
+
+            MethodBody body(make_unique<Compound>(
+                make_unique<IfElse>(make_unique<BoolConst>(runtime::Bool(true)),
+                    make_unique<Compound>(make_unique<Return>(make_unique<NumericConst>(57))), nullptr),
+                Print::Variable("unreachable"s)));
+
+            ObjectHolder result;
+            ASSERT_DOESNT_THROW(result = body.Execute(closure, context));
+            ASSERT_OBJECT_VALUE_EQUAL(result, 57);
+            ASSERT(context.GetCompletion() == runtime::Completion::NORMAL);
+            ASSERT(closure.empty());
+            ASSERT(context.output.str().empty());
+
+            MethodBody no_return(make_unique<Compound>(make_unique<NumericConst>(1)));
+            ASSERT(!no_return.Execute(closure, context));
+        }
+
+        void TestMethodCallInlineCache() {
+            runtime::DummyContext context;
+            runtime::CacheCountingScope counting;
+
+            vector<unique_ptr<runtime::Class>> classes;
+            vector<ObjectHolder> instances;
+            for (int i = 0; i < 6; ++i) {
+                vector<runtime::Method> methods;
+                methods.push_back({ "get"s, {}, make_unique<NumericConst>(i) });
+                classes.push_back(make_unique<runtime::Class>("C"s + to_string(i), std::move(methods), nullptr));
+                instances.push_back(ObjectHolder::Own(runtime::ClassInstance{ *classes.back() }));
+            }
+
+            MethodCall call(make_unique<VariableValue>("x"s), "get"s, {});
+            using State = runtime::InlineCache::State;
+            ASSERT(call.GetCache().GetState() == State::UNINITIALIZED);
+
+            Closure closure = { {"x"s, instances[0]} };
+            for (int i = 0; i < 3; ++i) {
+                ASSERT_OBJECT_VALUE_EQUAL(call.Execute(closure, context), 0);
+            }
+            ASSERT(call.GetCache().GetState() == State::MONOMORPHIC);
+            ASSERT_EQUAL(call.GetCache().GetMisses(), 1U);
+            ASSERT_EQUAL(call.GetCache().GetHits(), 2U);
+
+            for (int i = 1; i < 4; ++i) {
+                closure["x"s] = instances[i];
+                ASSERT_OBJECT_VALUE_EQUAL(call.Execute(closure, context), i);
+                ASSERT(call.GetCache().GetState() == State::POLYMORPHIC);
+            }
+            closure["x"s] = instances[2];
+            ASSERT_OBJECT_VALUE_EQUAL(call.Execute(closure, context), 2);
+            ASSERT_EQUAL(call.GetCache().GetMisses(), 4U);
+            ASSERT_EQUAL(call.GetCache().GetHits(), 3U);
+
+            closure["x"s] = instances[4];
+            ASSERT_OBJECT_VALUE_EQUAL(call.Execute(closure, context), 4);
+            ASSERT(call.GetCache().GetState() == State::MEGAMORPHIC);
+            closure["x"s] = instances[5];
+            ASSERT_OBJECT_VALUE_EQUAL(call.Execute(closure, context), 5);
+            //      - 
+            ASSERT_EQUAL(call.GetCache().GetMisses(), 6U);
+            ASSERT_EQUAL(call.GetCache().GetHits(), 3U);
+
+            MethodCall missing(make_unique<VariableValue>("x"s), "missing"s, {});
+            ASSERT_THROWS(missing.Execute(closure, context), std::runtime_error);
+        }
+
     }  // namespace
 
     void RunUnitTests(TestRunner& tr) {
         RUN_TEST(tr, ast::TestNumericConst);
         RUN_TEST(tr, ast::TestStringConst);
+        RUN_TEST(tr, ast::TestConstantsPerContext);
         RUN_TEST(tr, ast::TestVariable);
         RUN_TEST(tr, ast::TestAssignment);
         RUN_TEST(tr, ast::TestFieldAssignment);
@@ -465,10 +644,12 @@ namespace ast {
         RUN_TEST(tr, ast::TestPrintMultipleStatements);
         RUN_TEST(tr, ast::TestStringify);
         RUN_TEST(tr, ast::TestNumbersAddition);
+        RUN_TEST(tr, ast::TestIntegerOverflowPromotion);
         RUN_TEST(tr, ast::TestStringsAddition);
         RUN_TEST(tr, ast::TestBadAddition);
         RUN_TEST(tr, ast::TestSuccessfulClassInstanceAdd);
         RUN_TEST(tr, ast::TestClassInstanceAddWithoutMethod);
+        RUN_TEST(tr, ast::TestOperatorOverloading);
         RUN_TEST(tr, ast::TestCompound);
         RUN_TEST(tr, ast::TestFields);
         RUN_TEST(tr, ast::TestBaseClass);
@@ -476,6 +657,8 @@ namespace ast {
         RUN_TEST(tr, ast::TestOr);
         RUN_TEST(tr, ast::TestAnd);
         RUN_TEST(tr, ast::TestNot);
+        RUN_TEST(tr, ast::TestReturnStopsMethodBody);
+        RUN_TEST(tr, ast::TestMethodCallInlineCache);
     }
 
 }  // namespace ast
\ No newline at end of file